@@ -0,0 +1,221 @@
+/**
+ * Bakalarska praca - Simualace pevnych teles
+ * VUT FIT, 2018/2019
+ *
+ * Autor:	Denis Leitner, xleitn02
+ * Subor:	BroadPhaseBenchmark.cpp
+ *
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "Scene.h"
+#include "BroadPhaseTuner.h"
+
+constexpr float timeStep = 0.01f;
+const glm::vec3 GRAVITY = glm::vec3(0.0f, -9.8f, 0.0f);
+
+/**
+ * @brief Measured broad phase and its results
+ */
+struct BenchmarkEntry
+{
+	std::string name;
+	BroadPhase* broadPhase;
+	// summed time of updates and pair queries in milliseconds
+	double updateTime;
+	double findPairsTime;
+	unsigned long long pairs;
+	// number of frames in which found pairs differ from brute force
+	unsigned mismatchedFrames;
+	// number of frames in which some objects were rejected
+	unsigned rejectedFrames;
+};
+
+/**
+ * @brief Moves dynamic objects ballistically, objects bounce off the initial lowest level of dynamic objects
+ * @param objects Dynamic objects to move
+ * @param floor Height of the bouncing plane
+ */
+void moveObjects(const std::vector<Object*>& objects, float floor)
+{
+	for (auto & object : objects)
+	{
+		Object::Configuration& configuration = object->configuration;
+
+		configuration.velocityVector += timeStep * GRAVITY;
+		configuration.position += timeStep * configuration.velocityVector;
+		object->aabb->recomputeAABB(object);
+
+		if (object->aabb->min.y < floor && configuration.velocityVector.y < 0.0f)
+			configuration.velocityVector.y = -configuration.velocityVector.y;
+	}
+}
+
+/**
+ * @brief Converts found pairs into sorted list of pairs with ordered members, so that results
+ *        of different broad phases can be compared
+ * @param pairs Pairs found by broad phase
+ * @return Normalized pairs
+ */
+std::vector<std::pair<Object*, Object*>> normalizePairs(const std::vector<ObjectPair>& pairs)
+{
+	std::vector<std::pair<Object*, Object*>> normalized;
+	normalized.reserve(pairs.size());
+
+	for (auto & pair : pairs)
+		normalized.push_back(std::minmax(pair.object0, pair.object1));
+
+	std::sort(normalized.begin(), normalized.end());
+	return normalized;
+}
+
+int main(int argc, char** argv)
+{
+	// usage: BroadPhaseBenchmark [scene number] [number of frames]
+	int sceneNumber = argc > 1 ? atoi(argv[1]) : 1000;
+	int frames = argc > 2 ? atoi(argv[2]) : 100;
+
+	Scene scene;
+	fs::path scenePath = fs::u8path(ROOT_DIR);
+	scenePath += fs::path("Scenes/scene_" + std::to_string(sceneNumber));
+
+	if (!scene.loadScene(scenePath))
+		return 1;
+
+	std::vector<Object*> dynamicObjects;
+	float floor = INFINITY;
+
+	for (auto & object : scene.objects)
+	{
+		object->aabb->recomputeAABB(object);
+
+		if (object->mass != INFINITY)
+		{
+			dynamicObjects.push_back(object);
+			floor = std::min(floor, object->aabb->min.y);
+		}
+	}
+
+	BroadPhaseTuner tuner;
+	BroadPhaseSettings tuned = tuner.analyseScene(scene.objects);
+
+	BroadPhaseSettings bruteForceSettings;
+	bruteForceSettings.type = bruteForce;
+	BroadPhaseSettings uniformDefault;
+	uniformDefault.type = uniformGrid;
+	BroadPhaseSettings uniformTuned = tuned;
+	uniformTuned.type = uniformGrid;
+	BroadPhaseSettings hierarchicalDefault;
+	hierarchicalDefault.type = hierarchicalGrid;
+	BroadPhaseSettings hierarchicalTuned = tuned;
+	hierarchicalTuned.type = hierarchicalGrid;
+	BroadPhaseSettings linearBVHSettings = tuned;
+	linearBVHSettings.type = linearBVH;
+
+	std::vector<std::pair<std::string, BroadPhaseSettings>> configurations = {
+		{ "brute force", bruteForceSettings },
+		{ "uniform grid (default)", uniformDefault },
+		{ "uniform grid (tuned)", uniformTuned },
+		{ "hierarchical grid (default)", hierarchicalDefault },
+		{ "hierarchical grid (tuned)", hierarchicalTuned },
+		{ "linear BVH", linearBVHSettings }
+	};
+
+	ThreadPool threadPool;
+
+	std::vector<BenchmarkEntry> entries;
+
+	for (auto & configuration : configurations)
+	{
+		BroadPhase* broadPhase = BroadPhase::create(configuration.second, &threadPool);
+		if (broadPhase == NULL)
+		{
+			std::cout << "Could not create " << configuration.first << std::endl;
+			continue;
+		}
+
+		for (auto & object : scene.objects)
+		{
+			// half-spaces and meshes bypass broad phase in simulation
+			if (object->mass == INFINITY && object->model->shape->type != halfSpace && object->model->shape->type != mesh)
+				broadPhase->insertStaticObject(object);
+		}
+
+		entries.push_back({ configuration.first, broadPhase, 0.0, 0.0, 0, 0, 0 });
+	}
+
+	if (entries.empty() || entries[0].broadPhase->getName() != std::string("brute force"))
+		return 1;
+
+	std::cout << "Scene " << sceneNumber << ": " << dynamicObjects.size() << " dynamic objects, "
+		<< scene.objects.size() - dynamicObjects.size() << " static objects, " << frames << " frames, "
+		<< threadPool.getThreadCount() << " threads" << std::endl;
+
+	std::vector<ObjectPair> pairs;
+	std::vector<std::pair<Object*, Object*>> reference;
+
+	for (int frame = 0; frame < frames; frame++)
+	{
+		moveObjects(dynamicObjects, floor);
+
+		for (auto & entry : entries)
+		{
+			pairs.clear();
+
+			auto start = std::chrono::steady_clock::now();
+			entry.broadPhase->update(dynamicObjects);
+			auto middle = std::chrono::steady_clock::now();
+			entry.broadPhase->findPairs(pairs);
+			auto end = std::chrono::steady_clock::now();
+
+			entry.updateTime += std::chrono::duration<double, std::milli>(middle - start).count();
+			entry.findPairsTime += std::chrono::duration<double, std::milli>(end - middle).count();
+			entry.pairs += pairs.size();
+
+			if (&entry == &entries[0])
+			{
+				// brute force is the reference
+				reference = normalizePairs(pairs);
+				continue;
+			}
+
+			if (entry.broadPhase->rejectedObjects > 0)
+			{
+				// results of broad phase with objects out of grid are incomplete
+				entry.rejectedFrames++;
+				continue;
+			}
+
+			if (normalizePairs(pairs) != reference)
+				entry.mismatchedFrames++;
+		}
+	}
+
+	bool mismatch = false;
+
+	printf("\n%-30s %12s %12s %12s %10s %10s\n", "broad phase", "update [ms]", "pairs [ms]", "pairs/frame", "rejected", "mismatch");
+	for (auto & entry : entries)
+	{
+		printf("%-30s %12.4f %12.4f %12.1f %10u %10u\n", entry.name.c_str(), entry.updateTime / frames,
+			entry.findPairsTime / frames, (double)entry.pairs / frames, entry.rejectedFrames, entry.mismatchedFrames);
+
+		mismatch = mismatch || entry.mismatchedFrames > 0;
+		delete entry.broadPhase;
+	}
+
+	if (mismatch)
+	{
+		std::cout << "Some broad phase found different pairs than brute force" << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
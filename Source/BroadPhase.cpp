@@ -0,0 +1,84 @@
+/**
+ * Bakalarska praca - Simualace pevnych teles
+ * VUT FIT, 2018/2019
+ *
+ * Autor:	Denis Leitner, xleitn02
+ * Subor:	BroadPhase.cpp
+ *
+ */
+
+#include "BroadPhase.h"
+#include "BruteForceBroadPhase.h"
+#include "GridBroadPhase.h"
+#include "HierarchicalGridBroadPhase.h"
+#include "LinearBVHBroadPhase.h"
+
+
+BroadPhaseSettings::BroadPhaseSettings()
+{
+	type = uniformGrid;
+	cellSize = CELL_SIZE;
+	gridOrigin = glm::vec3(MIN_WIDTH_COORD, MIN_HEIGHT_COORD, MIN_DEPTH_COORD);
+	gridSize = glm::uvec3(GRID_HEIGHT, GRID_WIDTH, GRID_DEPTH);
+	levels = HGRID_LEVELS;
+	treeMargin = 0.0f;
+}
+
+BroadPhase::BroadPhase()
+{
+	rejectedObjects = 0;
+}
+
+BroadPhase::~BroadPhase() = default;
+
+bool BroadPhase::checkCollisionAABBs(AABB* a, AABB* b)
+{
+	if (a->max.x < b->min.x || a->min.x > b->max.x) 
+		return false;
+	if (a->max.y < b->min.y || a->min.y > b->max.y) 
+		return false;
+	if (a->max.z < b->min.z || a->min.z > b->max.z) 
+		return false;
+
+	return true;
+}
+
+BroadPhase* BroadPhase::create(const BroadPhaseSettings& settings, ThreadPool* threadPool)
+{
+	try
+	{
+		switch (settings.type)
+		{
+		case uniformGrid:
+		{
+			GridBroadPhase* gridBroadPhase = new GridBroadPhase(settings);
+			if (gridBroadPhase->grid == NULL)
+			{
+				// memory for grid cells couldn't be allocated
+				delete gridBroadPhase;
+				return NULL;
+			}
+			return gridBroadPhase;
+		}
+		case hierarchicalGrid:
+		{
+			HierarchicalGridBroadPhase* hierarchicalBroadPhase = new HierarchicalGridBroadPhase(settings);
+			if (hierarchicalBroadPhase->grid->levels.empty())
+			{
+				// memory for grid levels couldn't be allocated
+				delete hierarchicalBroadPhase;
+				return NULL;
+			}
+			return hierarchicalBroadPhase;
+		}
+		case linearBVH:
+			return new LinearBVHBroadPhase(settings, threadPool);
+		default:
+			return new BruteForceBroadPhase();
+		}
+	}
+	catch (const std::bad_alloc&)
+	{
+		return NULL;
+	}
+}
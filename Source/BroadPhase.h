@@ -0,0 +1,107 @@
+/**
+ * Bakalarska praca - Simualace pevnych teles
+ * VUT FIT, 2018/2019
+ *
+ * Autor:	Denis Leitner, xleitn02
+ * Subor:	BroadPhase.h
+ *
+ */
+
+#pragma once
+
+#ifndef BROAD_PHASE_H
+#define BROAD_PHASE_H
+
+#include <vector>
+#include "Grid.h"
+#include "HierarchicalGrid.h"
+#include "ThreadPool.h"
+
+enum BroadPhaseType { bruteForce, uniformGrid, hierarchicalGrid, linearBVH };
+
+/**
+ * @brief Algorithm and parameters of broad-phase collision detection
+ */
+struct BroadPhaseSettings
+{
+	BroadPhaseType type;
+	// edge length of one cell, for hierarchical grid of the finest level
+	float cellSize;
+	// world-space coordinates of the minimal corner of the grid
+	glm::vec3 gridOrigin;
+	// number of cells in format x: height, y: width, z: depth
+	glm::uvec3 gridSize;
+	// number of levels of hierarchical grid
+	unsigned levels;
+	// margin by which tree-based broad phases enlarge AABBs
+	float treeMargin;
+
+	/**
+	 * @brief Creates settings of uniform grid given by grid macros
+	 */
+	BroadPhaseSettings();
+};
+
+/**
+ * @brief Pair of objects whose AABBs overlap, at least one of them is dynamic
+ */
+struct ObjectPair
+{
+	Object* object0;
+	Object* object1;
+};
+
+/**
+ * @brief Abstract class for broad-phase collision detection
+ */
+class BroadPhase
+{
+public:
+	// number of objects that couldn't be processed in the last update, e.g. objects out of grid
+	unsigned rejectedObjects;
+
+	BroadPhase();
+	virtual ~BroadPhase();
+
+	/**
+	 * @brief Inserts static object, static objects are inserted once before the first update
+	 * @param object Object to be inserted
+	 * @return Whether object was inserted
+	 */
+	virtual bool insertStaticObject(Object* object) = 0;
+
+	/**
+	 * @brief Updates broad phase with current state of dynamic objects
+	 * @param objects Dynamic objects of the scene, their AABBs must be up to date
+	 */
+	virtual void update(const std::vector<Object*>& objects) = 0;
+
+	/**
+	 * @brief Finds all pairs of objects whose AABBs overlap, every pair is reported once
+	 * @param[out] pairs Found pairs are appended here
+	 */
+	virtual void findPairs(std::vector<ObjectPair>& pairs) = 0;
+
+	/**
+	 * @brief Gets name of the algorithm
+	 */
+	virtual const char* getName() = 0;
+
+	/**
+	 * @brief Checks whether 2 AABBs overlap
+	 * @param aabb0 First AABB to check
+	 * @param aabb1 Second AABB to check
+	 * @return Whether 2 AABBs overlap
+	 */
+	static bool checkCollisionAABBs(AABB* aabb0, AABB* aabb1);
+
+	/**
+	 * @brief Creates broad phase of given type
+	 * @param settings Type and parameters of broad phase
+	 * @param threadPool Threads used by parallel broad phases, NULL for single-threaded run
+	 * @return Created broad phase or NULL if memory could not be allocated
+	 */
+	static BroadPhase* create(const BroadPhaseSettings& settings, ThreadPool* threadPool = NULL);
+};
+
+#endif
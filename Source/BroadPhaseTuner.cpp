@@ -0,0 +1,239 @@
+/**
+ * Bakalarska praca - Simualace pevnych teles
+ * VUT FIT, 2018/2019
+ *
+ * Autor:	Denis Leitner, xleitn02
+ * Subor:	BroadPhaseTuner.cpp
+ *
+ */
+
+#include "BroadPhaseTuner.h"
+#include <algorithm>
+#include <cmath>
+
+
+BroadPhaseTuner::BroadPhaseTuner()
+{
+	baselineEfficiency = -1.0f;
+	stepsSinceTuning = 0;
+	gridBounded = false;
+	sceneBounded = false;
+	resetInterval();
+}
+
+BroadPhaseSettings BroadPhaseTuner::analyseScene(const std::vector<Object*>& objects)
+{
+	BroadPhaseSettings settings;
+
+	// new settings need new baseline
+	baselineEfficiency = -1.0f;
+	stepsSinceTuning = 0;
+	gridBounded = false;
+	resetInterval();
+
+	sceneMin = glm::vec3(FLT_MAX);
+	sceneMax = glm::vec3(-FLT_MAX);
+	sceneBounded = false;
+
+	for (auto & object : objects)
+	{
+		AABB* aabb = object->aabb;
+		bool finite = glm::all(glm::lessThan(glm::abs(aabb->min), glm::vec3(FLT_MAX)))
+			&& glm::all(glm::lessThan(glm::abs(aabb->max), glm::vec3(FLT_MAX)));
+
+		// unbounded half-spaces don't limit the scene
+		if (object->mass != INFINITY || !finite)
+			continue;
+
+		sceneMin = glm::min(sceneMin, aabb->min);
+		sceneMax = glm::max(sceneMax, aabb->max);
+		sceneBounded = true;
+	}
+
+	// sizes of dynamic objects and region occupied by them
+	std::vector<float> extents;
+	glm::vec3 regionMin = glm::vec3(FLT_MAX);
+	glm::vec3 regionMax = glm::vec3(-FLT_MAX);
+
+	for (auto & object : objects)
+	{
+		if (object->mass == INFINITY)
+			continue;
+
+		glm::vec3 extent = object->aabb->max - object->aabb->min;
+		extents.push_back(std::max(extent.x, std::max(extent.y, extent.z)));
+
+		regionMin = glm::min(regionMin, object->aabb->min);
+		regionMax = glm::max(regionMax, object->aabb->max);
+	}
+
+	if (extents.size() <= BRUTE_FORCE_MAX_OBJECTS)
+	{
+		// checking all pairs is cheaper than maintaining any structure
+		settings.type = bruteForce;
+		return settings;
+	}
+
+	std::sort(extents.begin(), extents.end());
+
+	// percentiles are used so that few outliers don't decide
+	unsigned outliers = extents.size() / 20;
+	float smallExtent = std::max(extents[outliers], EPSILON);
+	float largeExtent = std::max(extents[extents.size() - 1 - outliers], EPSILON);
+	float medianExtent = extents[extents.size() / 2];
+	float maxExtent = extents.back();
+
+	settings.treeMargin = 0.1f * medianExtent;
+
+	if (extents.size() >= LBVH_MIN_OBJECTS)
+	{
+		// grids are filled by one thread, tree is built and queried by all of them
+		settings.type = linearBVH;
+		return settings;
+	}
+
+	// leave space for objects to move
+	glm::vec3 margin = glm::max(0.25f * (regionMax - regionMin), glm::vec3(2.0f * largeExtent));
+	regionMin -= margin;
+	regionMax += margin;
+
+	// static objects under or above dynamic objects (e.g. ground) are part of the region
+	for (auto & object : objects)
+	{
+		if (object->mass != INFINITY)
+			continue;
+
+		AABB* aabb = object->aabb;
+		if (aabb->max.x < regionMin.x || aabb->min.x > regionMax.x || aabb->max.z < regionMin.z || aabb->min.z > regionMax.z)
+			continue;
+
+		regionMin.y = std::min(regionMin.y, aabb->min.y);
+		regionMax.y = std::max(regionMax.y, aabb->max.y);
+	}
+
+	float cellSize;
+
+	if (largeExtent / smallExtent > HIERARCHY_SIZE_SPREAD)
+	{
+		// finest level fits small objects, coarser levels are added until the largest object fits
+		settings.type = hierarchicalGrid;
+		cellSize = smallExtent;
+	}
+	else
+	{
+		// most objects occupy at most 2 cells along each axis
+		settings.type = uniformGrid;
+		cellSize = largeExtent;
+	}
+
+	glm::vec3 regionExtent = regionMax - regionMin;
+
+	while (true)
+	{
+		settings.gridSize.x = std::max(1u, static_cast<unsigned>(std::ceil(regionExtent.y / cellSize)));
+		settings.gridSize.y = std::max(1u, static_cast<unsigned>(std::ceil(regionExtent.x / cellSize)));
+		settings.gridSize.z = std::max(1u, static_cast<unsigned>(std::ceil(regionExtent.z / cellSize)));
+
+		float cellCount = (float)settings.gridSize.x * settings.gridSize.y * settings.gridSize.z;
+		if (cellCount <= MAX_GRID_CELLS)
+			break;
+
+		// too many cells, make them larger
+		cellSize *= std::cbrt(cellCount / MAX_GRID_CELLS) * 1.01f;
+	}
+
+	settings.cellSize = cellSize;
+	settings.gridOrigin = regionMin;
+
+	gridMin = regionMin;
+	gridMax = regionMax;
+	gridBounded = true;
+
+	settings.levels = 1;
+	while (settings.levels < HGRID_MAX_LEVELS && cellSize * (1 << (settings.levels - 1)) < maxExtent)
+		settings.levels++;
+
+	return settings;
+}
+
+void BroadPhaseTuner::recordStep(unsigned candidatePairs, unsigned collidingPairs)
+{
+	this->steps++;
+	this->stepsSinceTuning++;
+	this->candidatePairs += candidatePairs;
+	this->collidingPairs += collidingPairs;
+}
+
+bool BroadPhaseTuner::needsRegrid(const std::vector<Object*>& dynamicObjects)
+{
+	// objects that keep leaving the grid can't make it rebuild every step
+	if (!gridBounded || stepsSinceTuning < REGRID_MIN_STEPS)
+		return false;
+
+	for (auto & object : dynamicObjects)
+	{
+		AABB* aabb = object->aabb;
+
+		if (aabb->min.x >= gridMin.x && aabb->min.y >= gridMin.y && aabb->min.z >= gridMin.z
+			&& aabb->max.x <= gridMax.x && aabb->max.y <= gridMax.y && aabb->max.z <= gridMax.z)
+			continue;
+
+		// object fell below or out of the static scene, it has nothing to collide with
+		if (sceneBounded && (aabb->max.y < sceneMin.y
+			|| aabb->max.x < sceneMin.x || aabb->min.x > sceneMax.x
+			|| aabb->max.z < sceneMin.z || aabb->min.z > sceneMax.z))
+			continue;
+
+		return true;
+	}
+
+	return false;
+}
+
+bool BroadPhaseTuner::needsRetuning()
+{
+	if (steps < RETUNE_INTERVAL)
+		return false;
+
+	float efficiency = (float)collidingPairs / std::max(candidatePairs, 1ull);
+
+	resetInterval();
+
+	if (baselineEfficiency < 0.0f)
+	{
+		// first interval after tuning
+		baselineEfficiency = efficiency;
+		return false;
+	}
+
+	return efficiency < baselineEfficiency * RETUNE_EFFICIENCY_DROP;
+}
+
+void BroadPhaseTuner::printSettings(const BroadPhaseSettings& settings)
+{
+	switch (settings.type)
+	{
+	case bruteForce:
+		std::cout << "Broad-phase: all pairs of objects are checked" << std::endl;
+		return;
+	case linearBVH:
+		std::cout << "Broad-phase: linear BVH, margin " << settings.treeMargin << std::endl;
+		return;
+	case uniformGrid:
+		std::cout << "Broad-phase: uniform grid";
+		break;
+	case hierarchicalGrid:
+		std::cout << "Broad-phase: hierarchical grid with " << settings.levels << " levels";
+		break;
+	}
+
+	std::cout << ", cell size " << settings.cellSize << ", " << settings.gridSize.y << " x " << settings.gridSize.x
+		<< " x " << settings.gridSize.z << " cells, origin " << glm::to_string(settings.gridOrigin) << std::endl;
+}
+
+void BroadPhaseTuner::resetInterval()
+{
+	steps = 0;
+	candidatePairs = 0;
+	collidingPairs = 0;
+}
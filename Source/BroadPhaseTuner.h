@@ -0,0 +1,94 @@
+/**
+ * Bakalarska praca - Simualace pevnych teles
+ * VUT FIT, 2018/2019
+ *
+ * Autor:	Denis Leitner, xleitn02
+ * Subor:	BroadPhaseTuner.h
+ *
+ */
+
+#pragma once
+
+#ifndef BROAD_PHASE_TUNER_H
+#define BROAD_PHASE_TUNER_H
+
+#include <vector>
+#include "BroadPhase.h"
+
+#define BRUTE_FORCE_MAX_OBJECTS 24		// up to this number of dynamic objects broad phase is not worth it
+#define HIERARCHY_SIZE_SPREAD 4.0f		// ratio of large to small objects from which hierarchical grid is used
+#define MAX_GRID_CELLS 600000			// upper limit of cells of one grid
+#define LBVH_MIN_OBJECTS 20000			// from this number of dynamic objects parallel linear BVH is used
+#define RETUNE_INTERVAL 200				// number of steps over which pair efficiency is measured
+#define RETUNE_EFFICIENCY_DROP 0.5f		// relative drop of pair efficiency that triggers retuning
+#define REGRID_MIN_STEPS 50				// minimal number of steps between rebuilds caused by objects leaving the grid
+
+/**
+ * @brief Chooses broad-phase algorithm and its parameters from scene statistics
+ *        and watches pair efficiency of the chosen broad phase at runtime
+ */
+class BroadPhaseTuner
+{
+public:
+	BroadPhaseTuner();
+
+	/**
+	 * @brief Analyses AABB size distribution, number of objects and spatial extent of the scene
+	 * @param objects Objects of the scene, AABBs must be up to date
+	 * @return Settings of broad phase suitable for the scene
+	 */
+	BroadPhaseSettings analyseScene(const std::vector<Object*>& objects);
+
+	/**
+	 * @brief Stores statistics of one simulation step
+	 * @param candidatePairs Number of pairs passed to narrow phase
+	 * @param collidingPairs Number of pairs that actually collide
+	 */
+	void recordStep(unsigned candidatePairs, unsigned collidingPairs);
+
+	/**
+	 * @brief Checks whether dynamic objects left region of the tuned grid while they are still within static scene,
+	 *        objects that fell below or out of the static scene are ignored; rebuilds are at least REGRID_MIN_STEPS apart
+	 * @param dynamicObjects Dynamic objects of the scene, AABBs must be up to date
+	 * @return Whether scene should be analysed again before pairs of this step are found
+	 */
+	bool needsRegrid(const std::vector<Object*>& dynamicObjects);
+
+	/**
+	 * @brief Checks whether pair efficiency drifted from the one measured after last tuning
+	 * @return Whether scene should be analysed again
+	 */
+	bool needsRetuning();
+
+	/**
+	 * @brief Prints settings to standard output
+	 */
+	void printSettings(const BroadPhaseSettings& settings);
+
+private:
+	// statistics of current measuring interval
+	unsigned steps;
+	unsigned long long candidatePairs;
+	unsigned long long collidingPairs;
+	// steps since the last tuning
+	unsigned stepsSinceTuning;
+
+	// region covered by the tuned grid, valid only if gridBounded
+	glm::vec3 gridMin;
+	glm::vec3 gridMax;
+	bool gridBounded;
+	// bounds of static objects with finite AABBs, valid only if sceneBounded
+	glm::vec3 sceneMin;
+	glm::vec3 sceneMax;
+	bool sceneBounded;
+
+	// pair efficiency measured in the first interval after tuning, negative if not measured yet
+	float baselineEfficiency;
+
+	/**
+	 * @brief Starts new measuring interval
+	 */
+	void resetInterval();
+};
+
+#endif
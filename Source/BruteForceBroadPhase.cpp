@@ -0,0 +1,53 @@
+/**
+ * Bakalarska praca - Simualace pevnych teles
+ * VUT FIT, 2018/2019
+ *
+ * Autor:	Denis Leitner, xleitn02
+ * Subor:	BruteForceBroadPhase.cpp
+ *
+ */
+
+#include "BruteForceBroadPhase.h"
+
+
+BruteForceBroadPhase::BruteForceBroadPhase() = default;
+
+bool BruteForceBroadPhase::insertStaticObject(Object* object)
+{
+	staticObjects.push_back(object);
+	return true;
+}
+
+void BruteForceBroadPhase::update(const std::vector<Object*>& objects)
+{
+	dynamicObjects = objects;
+}
+
+void BruteForceBroadPhase::findPairs(std::vector<ObjectPair>& pairs)
+{
+	unsigned numberOfObjects = dynamicObjects.size();
+
+	for (unsigned i = 0; i < numberOfObjects; i++)
+	{
+		Object* object0 = dynamicObjects[i];
+
+		for (unsigned j = i + 1; j < numberOfObjects; j++)
+		{
+			Object* object1 = dynamicObjects[j];
+
+			if (checkCollisionAABBs(object0->aabb, object1->aabb))
+				pairs.push_back({ object0, object1 });
+		}
+
+		for (auto & staticObject : staticObjects)
+		{
+			if (checkCollisionAABBs(object0->aabb, staticObject->aabb))
+				pairs.push_back({ object0, staticObject });
+		}
+	}
+}
+
+const char* BruteForceBroadPhase::getName()
+{
+	return "brute force";
+}
@@ -0,0 +1,35 @@
+/**
+ * Bakalarska praca - Simualace pevnych teles
+ * VUT FIT, 2018/2019
+ *
+ * Autor:	Denis Leitner, xleitn02
+ * Subor:	BruteForceBroadPhase.h
+ *
+ */
+
+#pragma once
+
+#ifndef BRUTE_FORCE_BROAD_PHASE_H
+#define BRUTE_FORCE_BROAD_PHASE_H
+
+#include "BroadPhase.h"
+
+/**
+ * @brief Broad phase checking AABBs of all pairs of objects, suitable for small scenes
+ */
+class BruteForceBroadPhase : public BroadPhase
+{
+public:
+	BruteForceBroadPhase();
+
+	bool insertStaticObject(Object* object) override;
+	void update(const std::vector<Object*>& objects) override;
+	void findPairs(std::vector<ObjectPair>& pairs) override;
+	const char* getName() override;
+
+private:
+	std::vector<Object*> staticObjects;
+	std::vector<Object*> dynamicObjects;
+};
+
+#endif
@@ -1,567 +1,2033 @@
-/**
- * Bakalarska praca - Simualace pevnych teles
- * VUT FIT, 2018/2019
- *
- * Autor:	Denis Leitner, xleitn02
- * Subor:	CollisionDetectionNarrow.cpp
- *
- */
-
-
-#include "CollisionDetectionNarrow.h"
-
-
-CollisionDetectionNarrow::CollisionDetectionNarrow()
-{
-}
-
-bool CollisionDetectionNarrow::checkCollision(CollisionData& collision, Object* object0, Object* object1)
-{
-	ShapeType shapeType0 = object0->model->shape->type;
-	ShapeType shapeType1 = object1->model->shape->type;
-
-	bool objectsCollide = false;
-
-	if (shapeType0 == sphere)
-	{
-		if (shapeType1 == sphere)
-		{
-			objectsCollide = checkCollisionSpheres(collision, object0, object1);
-		}
-		else if (shapeType1 == hull)
-		{
-			objectsCollide = checkCollisionHullSphere(collision, object1, object0);
-		}
-		else if (shapeType1 == plane)
-		{
-			objectsCollide = checkCollisionPlaneSphere(collision, object1, object0);
-		}
-	}
-	else if (shapeType0 == plane && shapeType1 == sphere)
-	{
-		objectsCollide = checkCollisionPlaneSphere(collision, object0, object1);
-	}
-	else		// shapeType0 == hull || shapeType0 == plane
-	{
-		if (shapeType1 == sphere)
-		{
-			if (shapeType0)
-			objectsCollide = checkCollisionHullSphere(collision, object0, object1);
-		}
-		else // shapeType1 == hull || shapeType1 == plane
-		{
-			objectsCollide = checkCollisionHulls(collision, object0, object1);
-		}
-
-	}
-
-	return objectsCollide;
-}
-
-bool CollisionDetectionNarrow::checkCollisionHulls(CollisionData& collision, Object * object0, Object * object1)
-{
-	FaceQuery faceQuery0 = testFaceNormals(object0, object1);
-	if (faceQuery0.separationDistance > 0.0f)
-	{
-		// no collision
-		return false;
-	}
-
-	FaceQuery faceQuery1 = testFaceNormals(object1, object0);
-	if (faceQuery1.separationDistance > 0.0f)
-	{
-		// no collision
-		return false;
-	}
-
-	// list of collision points
-	std::vector<glm::vec3> collisionPoints;
-
-	// tolerance constants
-	constexpr float linearSlop = 0.005f;
-	constexpr float relativeFaceTolerance = 0.98f;
-	constexpr float absoluteTolerance = 0.5f * linearSlop;
-
-	Object* queryObject0;
-	Object* queryObject1;
-
-	glm::vec3 collisionPoint;
-
-	FaceQuery query;
-	bool success = false;
-
-	// prefer one face query over other because of coherent contact points from frame to frame
-	if (faceQuery1.separationDistance > relativeFaceTolerance * faceQuery0.separationDistance + absoluteTolerance)
-	{
-		success = createFaceCollision(faceQuery1, collisionPoints);
-		query = faceQuery1;
-		Hull* hull = dynamic_cast<Hull*>(faceQuery1.object0->model->shape);
-		glm::vec3 collisionAxis = faceQuery1.object0->getRotationMatrix() * hull->faces[faceQuery1.faceIndex]->normal;
-		query.axis = collisionAxis;
-	}
-	else
-	{
-		success = createFaceCollision(faceQuery0, collisionPoints);
-		query = faceQuery0;
-		Hull* hull = dynamic_cast<Hull*>(faceQuery0.object0->model->shape);
-		glm::vec3 collisionAxis = faceQuery0.object0->getRotationMatrix() * hull->faces[faceQuery0.faceIndex]->normal;
-		query.axis = collisionAxis;
-	}
-	if (!success)
-		return false;
-
-	glm::vec3 sum = glm::vec3(0.0f);
-	unsigned collisionPointsCount = collisionPoints.size();
-
-	for (unsigned i = 0; i < collisionPointsCount; i++)
-	{
-		sum += collisionPoints[i];
-	}
-	collisionPoint = sum / (float)collisionPointsCount;
-
-	// couldn't create collision
-	if (collisionPoints.empty())
-		return false;
-
-	glm::vec3 collisionNormal = glm::normalize(query.axis);
-
-	queryObject0 = query.object0;
-	queryObject1 = query.object1;
-
-	float seperationDistance = std::abs(query.separationDistance);
-
-	auto position0 = queryObject0->getPosition();
-	auto position1 = queryObject1->getPosition();
-
-	if (glm::dot(position0 - position1, collisionNormal) < 0.0)
-	{
-		// collision normal doesn't point toward first object, flip it
-		collisionNormal = -collisionNormal;
-	}
-
-	pushObjectsOutOfCollision(queryObject0, queryObject1, collisionNormal, seperationDistance);
-
-	collision.object0 = queryObject0;
-	collision.object1 = queryObject1;
-	collision.collisionNormal = collisionNormal;
-	collision.collisionPoint = collisionPoint;
-
-	return true;
-}
-
-bool CollisionDetectionNarrow::checkCollisionSpheres(CollisionData& collision, Object* object0, Object* object1)
-{
-	Sphere* sphere0 = dynamic_cast<Sphere*>(object0->model->shape);
-	Sphere* sphere1 = dynamic_cast<Sphere*>(object1->model->shape);
-
-	glm::vec3 position0 = object0->configuration.position;
-	glm::vec3 position1 = object1->configuration.position;
-
-	float radius0 = sphere0->radius;
-	float radius1 = sphere1->radius;
-
-	float distance = glm::length(position1 - position0);
-	float sumOfRadii = radius0 + radius1;
-
-	float separation = distance - sumOfRadii;
-
-	if (separation > 0.0f)
-	{
-		// no separation
-		return false;
-	}
-
-	glm::vec3 collisionNormal;
-	if (position0 == position1)
-	{
-		// spheres are coincident
-		collisionNormal = glm::vec3(0.0f, 1.0f, 0.0f);
-	}
-	else
-	{
-		collisionNormal = glm::normalize(position0 - position1);
-	}
-
-	separation = std::abs(separation);
-	
-	pushObjectsOutOfCollision(object0, object1, collisionNormal, separation);
-
-	glm::vec3 collisionPoint = object1->getPosition() + collisionNormal * sphere1->radius;
-
-	collision.object0 = object0;
-	collision.object1 = object1;
-	collision.collisionNormal = collisionNormal;
-	collision.collisionPoint = collisionPoint;
-
-	return true;
-}
-
-bool CollisionDetectionNarrow::checkCollisionPlaneSphere(CollisionData& collision, Object* planeObject, Object* sphereObject)
-{
-	PlaneShape* plane = dynamic_cast<PlaneShape*>(planeObject->model->shape);
-	Sphere* sphere = dynamic_cast<Sphere*>(sphereObject->model->shape);
-
-	glm::mat4 transformationMatrix = planeObject->getModelMatrix();
-	glm::mat3 rotationMatrix = planeObject->getRotationMatrix();
-
-	HalfEdge* firstEdge = *(plane->edges.begin());
-	HalfEdge* edge = firstEdge;
-
-	// check if sphere is out of plane
-	do
-	{
-		heVertex sidePlaneVertex = { glm::vec3(transformationMatrix * glm::vec4(edge->head->position, 1.0f)) };
-
-		// normal of this side plane is direction vector of previous edge
-		glm::vec3 sidePlaneNormal = rotationMatrix * edge->previous->directionVector;
-
-		Plane sidePlane = { &sidePlaneVertex, sidePlaneNormal };
-
-		heVertex supportPoint = { sphere->getSupport(-sidePlane.normal, sphereObject->getPosition()) };
-		float distance = supportPoint.distanceFromPlane(sidePlane);
-
-		if (distance > 0.0f)
-		{
-			return false;
-		}
-
-		edge = edge->next;
-	} while (edge != firstEdge);
-
-	return checkCollisionHullSphere(collision, planeObject, sphereObject);
-}
-
-
-bool CollisionDetectionNarrow::checkCollisionHullSphere(CollisionData& collision, Object* hullObject, Object* sphereObject)
-{
-	Hull* hull = dynamic_cast<Hull*>(hullObject->model->shape);
-	Sphere* sphere = dynamic_cast<Sphere*>(sphereObject->model->shape);
-
-	glm::mat4 transformationMatrix = hullObject->getModelMatrix();
-	glm::mat3 rotationMatrix = hullObject->getRotationMatrix();
-	glm::vec3 spherePosition = sphereObject->getPosition();
-
-	glm::vec3 collisionNormal = glm::vec3(0.0f);
-
-	float bestDistance = -FLT_MAX;
-	int bestFaceIndex = -1;
-
-	for (unsigned int i = 0; i < hull->faces.size(); i++)
-	{
-		auto face = hull->faces[i];
-		heVertex pointOnPlane = { transformationMatrix * glm::vec4(face->edge->tail->position, 1.0f) };
-		glm::vec3 planeNormal = rotationMatrix * face->normal;
-
-		Plane planeA = { &pointOnPlane, planeNormal };
-		heVertex supportPoint = { sphere->getSupport(-planeA.normal, spherePosition) };
-
-		float distance = supportPoint.distanceFromPlane(planeA);
-
-		if (distance > 0.0f)
-		{
-			return false;
-		}
-
-		if (distance > bestDistance)
-		{
-			bestDistance = distance;
-			bestFaceIndex = i;
-			collisionNormal = planeNormal;
-		}
-	}
-
-	if (bestFaceIndex < 0)
-		return false;
-
-	bestDistance = std::abs(bestDistance);
-
-	for (auto & edge : hull->uniqueEdges)
-	{
-		glm::vec3 edgeCenter = (edge->tail->position + edge->head->position) / 2.0f;
-		edgeCenter = transformationMatrix * glm::vec4(edgeCenter, 1.0f);
-		glm::vec3 axis = rotationMatrix * glm::normalize(edgeCenter - spherePosition);
-
-		interval hullProjectionInterval = hull->getProjectionInterval(axis, transformationMatrix);
-		interval sphereProjectionInterval = sphere->getProjectionInterval(axis, spherePosition);
-
-		if (!overlap(hullProjectionInterval, sphereProjectionInterval))
-		{
-			return false;
-		}
-
-		float overlapAmount;
-
-		if (hullProjectionInterval.min < sphereProjectionInterval.min)
-		{
-			overlapAmount = std::abs(hullProjectionInterval.max - sphereProjectionInterval.min);
-		}
-		else
-		{
-			overlapAmount = std::abs(sphereProjectionInterval.max - hullProjectionInterval.min);
-		}
-
-		if (overlapAmount < bestDistance)
-		{
-			bestDistance = overlapAmount;
-			collisionNormal = axis;
-		}
-	}
-
-	if (glm::dot(hullObject->getPosition() - sphereObject->getPosition(), collisionNormal) < 0.0)
-	{
-		// collision normal doesn't point toward hull object, flip it
-		collisionNormal = -collisionNormal;
-	}
-
-	pushObjectsOutOfCollision(hullObject, sphereObject, collisionNormal, bestDistance);
-
-	glm::vec3 collisionPoint = sphereObject->getPosition() + collisionNormal * sphere->radius;
-
-	collision.object0 = hullObject;
-	collision.object1 = sphereObject;
-	collision.collisionNormal = collisionNormal;
-	collision.collisionPoint = collisionPoint;
-
-	return true;
-}
-
-void CollisionDetectionNarrow::pushObjectsOutOfCollision(Object* object0, Object* object1, const glm::vec3& collisionNormal, float seperationDistance)
-{
-	Object::Configuration& configuration0 = object0->configuration;
-	Object::Configuration& configuration1 = object1->configuration;
-
-	// push objects out of collision
-	glm::vec3 push = collisionNormal * seperationDistance;
-
-	if (object0->mass != INFINITY && object1->mass != INFINITY)
-		// both objects are dynamic
-		push = push / 2.0f;
-
-	if (object0->density != INFINITY)
-		configuration0.position += push;
-
-	if (object1->density != INFINITY)
-		configuration1.position -= push;
-}
-
-void CollisionDetectionNarrow::SutherlandHodgman(const std::vector<heVertex>& polygon, const Plane& plane, std::vector<heVertex>& out)
-{
-	// tail vertex of an edge
-	heVertex vertex1 = polygon.back();
-	float distance1 = vertex1.distanceFromPlane(plane);
-
-	for (unsigned int i = 0; i < polygon.size(); i++)
-	{
-		// head vertex of an edge
-		heVertex vertex2 = polygon[i];
-		float distance2 = vertex2.distanceFromPlane(plane);
-
-		if (distance1 <= 0.0f && distance2 <= 0.0f)
-		{
-			// both vertices are behind the plane
-			out.push_back(vertex2);
-		}
-		else if (distance1 <= 0.0f && distance2 > 0.0f)
-		{
-			// vertex1 is behind the plane, vertex 2 in front -> intersection
-			float fraction = distance1 / (distance1 - distance2);
-			glm::vec3 intersection = vertex1.position + fraction * (vertex2.position - vertex1.position);
-
-			// keep intersection point
-			out.push_back(intersection);
-		}
-		else if (distance2 <= 0.0f && distance1 > 0.0f)
-		{
-			// vertex2 is behind the plane, vertex 1 is in front
-			float fraction = distance1 / (distance1 - distance2);
-			glm::vec3 intersection = vertex1.position + fraction * (vertex2.position - vertex1.position);
-
-			// keep intersection point
-			out.push_back(intersection);
-
-			// and also vertex2
-			out.push_back(vertex2);
-		}
-		// keep vertex 2 as tail of the next edge
-		vertex1 = vertex2;
-		distance1 = distance2;
-	}
-}
-
-bool CollisionDetectionNarrow::createFaceCollision(FaceQuery& collisionQuery, std::vector<glm::vec3>& out)
-{
-	Object* object0 = collisionQuery.object0;
-	Object* object1 = collisionQuery.object1;
-
-	glm::mat3 rotationMatrixObject0 = object0->getRotationMatrix();
-	glm::mat4 transformationMatrixObject0 = object0->getModelMatrix();
-	glm::mat4 transformationMatrixObject1 = object1->getModelMatrix();
-
-	Hull* hull = dynamic_cast<Hull*>(object0->model->shape);
-
-	heFace* referenceFace = hull->faces[collisionQuery.faceIndex];
-	heFace* incidentFace = collisionQuery.findIncidentFace();
-
-	heVertex referenceFaceVertex = { transformationMatrixObject0 * glm::vec4(referenceFace->edge->tail->position, 1.0f) };
-	glm::vec3 referenceFaceNormal = rotationMatrixObject0 * referenceFace->normal;
-	Plane referencePlane = { &referenceFaceVertex, referenceFaceNormal };
-
-	HalfEdge* firstEdge = incidentFace->edge;
-	HalfEdge* currentEdge = firstEdge;
-	std::vector<heVertex> polygon;
-
-	// iterate through all incident face edges and build polygon
-	do
-	{
-		heVertex vertex = { currentEdge->tail->position };
-		vertex.position = transformationMatrixObject1 * glm::vec4(vertex.position, 1.0f);
-
-		polygon.push_back(vertex);
-		currentEdge = currentEdge->next;
-	} while (currentEdge != firstEdge);
-
-	firstEdge = referenceFace->edge;
-	currentEdge = firstEdge;
-
-	// iterate through all reference face edges
-	do
-	{
-		heVertex vertexA = { glm::vec3(transformationMatrixObject0 * glm::vec4(currentEdge->tail->position, 1.0f)) };
-		heVertex vertexB = { glm::vec3(transformationMatrixObject0 * glm::vec4(currentEdge->head->position, 1.0f)) };
-
-		// create side plane of an edge
-		glm::vec3 planeNormal = glm::cross(vertexB.position - vertexA.position, rotationMatrixObject0 * referenceFace->normal);
-		planeNormal = glm::normalize(planeNormal);
-		Plane clippingPlane = { &vertexA, planeNormal };
-
-		std::vector<heVertex> newPolygon = std::vector<heVertex>();
-
-		// clip plane with polygon (incident face)
-		SutherlandHodgman(polygon, clippingPlane, newPolygon);
-
-		polygon = newPolygon;
-
-		if (polygon.size() < 3)
-			return false;
-
-		currentEdge = currentEdge->next;
-	} while (currentEdge != firstEdge);
-
-
-	for (auto & vertex : polygon)
-	{
-		float distance;
-		// keep only vertices that are below reference face
-		if ((distance = vertex.distanceFromPlane(referencePlane)) < 0.0f)
-		{
-			// move contact point onto referencePlane
-			glm::vec3 contactPoint = vertex.position + referencePlane.normal * std::abs(distance);
-			out.push_back(contactPoint);
-		}
-	}
-	return true;
-}
-
-
-CollisionDetectionNarrow::Query::Query()
-{
-	object0 = NULL;
-	object1 = NULL;
-	axis = glm::vec3(0.0f);
-	separationDistance = 0.0f;
-}
-
-heFace* CollisionDetectionNarrow::FaceQuery::findIncidentFace()
-{
-	Hull* hull0 = dynamic_cast<Hull*>(object0->model->shape);
-	Hull* hull1 = dynamic_cast<Hull*>(object1->model->shape);
-
-	heFace* referenceFace = hull0->faces[faceIndex];
-	glm::vec3 referenceFaceNormal = object0->getRotationMatrix() * referenceFace->normal;
-
-	glm::mat3 rotationMatrixObject1 = object1->getRotationMatrix();
-
-	heFace* incidentFace = hull1->faces[0];
-	glm::vec3 faceNormal = rotationMatrixObject1 * incidentFace->normal;
-	float minimalDot = glm::dot(faceNormal, referenceFaceNormal);
-	
-
-	for (unsigned int i = 1; i < hull1->faces.size(); i++)
-	{
-		heFace* face = hull1->faces[i];
-		faceNormal = rotationMatrixObject1 * face->normal;
-		float dot = glm::dot(faceNormal, referenceFaceNormal);
-
-		// incident face is face with smallest dot product with reference face normal
-		if (dot < minimalDot)
-		{
-			minimalDot = dot;
-			incidentFace = face;
-		}
-	}
-
-	return incidentFace;
-}
-
-
-bool CollisionDetectionNarrow::overlap(interval interval0, interval interval1)
-{
-	return !((interval0.max < interval1.min) || (interval1.max < interval0.min));
-}
-
-
-CollisionDetectionNarrow::FaceQuery CollisionDetectionNarrow::testFaceNormals(Object* object0, Object* object1)
-{
-	FaceQuery query;
-	query.object0 = object0;
-	query.object1 = object1;
-	query.faceIndex = -1;
-	query.separationDistance = FLT_MAX;
-
-	Hull* hull0 = dynamic_cast<Hull*>(object0->model->shape);
-	Hull* hull1 = dynamic_cast<Hull*>(object1->model->shape);
-
-	float bestDistance = -FLT_MAX;
-	unsigned int bestFaceIndex = -1;
-	unsigned int faceCount = hull0->faces.size();
-	const auto & faces = hull0->faces;
-
-	glm::mat4 transformationMatrixObject0 = object0->getModelMatrix();
-	glm::mat4 transformationMatrixObject1 = object1->getModelMatrix();
-
-	glm::mat3 rotationMatrix = object0->getRotationMatrix();
-
-	for(unsigned int i = 0; i < faceCount; i++)
-	{
-		auto face = faces[i];
-		heVertex pointOnPlane = { transformationMatrixObject0 * glm::vec4(face->edge->tail->position, 1.0f) };
-		glm::vec3 planeNormal = rotationMatrix * face->normal;
-
-		Plane planeA = { &pointOnPlane, planeNormal };
-		heVertex supportPoint = { hull1->getSupport(-planeA.normal, transformationMatrixObject1) };
-
-		float distance = supportPoint.distanceFromPlane(planeA);
-
-		if (distance > 0.0f)
-		{
-			query.separationDistance = FLT_MAX;
-			return query;
-		}
-
-		if (distance > bestDistance)
-		{
-			bestDistance = distance;
-			bestFaceIndex = i;
-		}
-	}
-
-	query.faceIndex = bestFaceIndex;
-	query.separationDistance = bestDistance;
-
-	return query;
-}
-
-bool isZeroVector(glm::vec3 vector)
-{
-	return std::abs(glm::length(vector)) < EPSILON;
-}
+/**
+ * Bakalarska praca - Simualace pevnych teles
+ * VUT FIT, 2018/2019
+ *
+ * Autor:	Denis Leitner, xleitn02
+ * Subor:	CollisionDetectionNarrow.cpp
+ *
+ */
+
+
+#include "CollisionDetectionNarrow.h"
+#include <algorithm>
+
+
+CollisionDetectionNarrow::CollisionDetectionNarrow()
+{
+	for (unsigned i = 0; i < SHAPE_TYPE_COUNT; i++)
+		for (unsigned j = 0; j < SHAPE_TYPE_COUNT; j++)
+			collisionFunctions[i][j] = { NULL, false };
+
+	registerCollisionFunction(sphere, sphere, &CollisionDetectionNarrow::checkCollisionSpheres);
+	registerCollisionFunction(hull, sphere, &CollisionDetectionNarrow::checkCollisionHullSphere);
+	registerCollisionFunction(plane, sphere, &CollisionDetectionNarrow::checkCollisionPlaneSphere);
+	registerCollisionFunction(box, sphere, &CollisionDetectionNarrow::checkCollisionBoxSphere);
+
+	// hull routines take objects in any order
+	const ShapeType hullTypes[] = { hull, plane, box };
+	for (auto & type0 : hullTypes)
+		for (auto & type1 : hullTypes)
+			registerCollisionFunction(type0, type1, &CollisionDetectionNarrow::checkCollisionConvexHulls);
+
+	registerCollisionFunction(box, box, &CollisionDetectionNarrow::checkCollisionBoxes);
+
+	registerCollisionFunction(halfSpace, sphere, &CollisionDetectionNarrow::checkCollisionHalfSpaceSphere);
+	for (auto & type : hullTypes)
+		registerCollisionFunction(halfSpace, type, &CollisionDetectionNarrow::checkCollisionHalfSpaceHull);
+
+	registerCollisionFunction(mesh, sphere, &CollisionDetectionNarrow::checkCollisionMeshSphere);
+	for (auto & type : hullTypes)
+		registerCollisionFunction(mesh, type, &CollisionDetectionNarrow::checkCollisionMeshHull);
+
+	// compound splits pair into pairs of its children, those are dispatched again
+	for (unsigned type = 0; type < SHAPE_TYPE_COUNT; type++)
+		registerCollisionFunction(compound, (ShapeType)type, &CollisionDetectionNarrow::checkCollisionCompound);
+}
+
+bool CollisionDetectionNarrow::checkCollision(CollisionData& collision, Object* object0, Object* object1)
+{
+	const CollisionDispatch& dispatch = collisionFunctions[object0->model->shape->type][object1->model->shape->type];
+
+	if (dispatch.function == NULL)
+		return false;
+
+	if (dispatch.swapObjects)
+		return (this->*dispatch.function)(collision, object1, object0);
+
+	return (this->*dispatch.function)(collision, object0, object1);
+}
+
+void CollisionDetectionNarrow::checkCollisions(const std::vector<ObjectPair>& pairs, std::vector<CollisionData>& collisions)
+{
+	for (auto & group : pairGroups)
+		group.clear();
+
+	// objects of pair are ordered by shape type, so that all pairs of group are passed to its routine in the same way
+	for (auto & pair : pairs)
+	{
+		ShapeType type0 = pair.object0->model->shape->type;
+		ShapeType type1 = pair.object1->model->shape->type;
+
+		if (type0 <= type1)
+			pairGroups[type0 * SHAPE_TYPE_COUNT + type1].push_back(pair);
+		else
+			pairGroups[type1 * SHAPE_TYPE_COUNT + type0].push_back({ pair.object1, pair.object0 });
+	}
+
+	// pairs of the same shape types are processed by the same code one after another
+	for (unsigned group = 0; group < PAIR_GROUP_COUNT; group++)
+	{
+		const CollisionDispatch& dispatch = collisionFunctions[group / SHAPE_TYPE_COUNT][group % SHAPE_TYPE_COUNT];
+		const ObjectPair* groupPairs = pairGroups[group].data();
+		unsigned count = pairGroups[group].size();
+
+		if (dispatch.function == NULL)
+			continue;
+
+		for (unsigned first = 0; first < count; first += BATCH_SIZE)
+		{
+			const ObjectPair* batch = groupPairs + first;
+			unsigned batchSize = std::min(BATCH_SIZE, count - first);
+			// other shapes have no test cheaper than their routine, their pairs are passed to it directly;
+			// lanes are as wide as floats, so that whole batch is tested by packed instructions, bool lanes would narrow them
+			uint32_t separated[BATCH_SIZE] = {};
+
+			// routines don't move objects, so results of a batch don't depend on order of its pairs
+			if (group == SPHERE_GROUP)
+				findSeparatedSpheres(batch, batchSize, separated);
+
+			for (unsigned i = 0; i < batchSize; i++)
+			{
+				if (separated[i])
+					continue;
+
+				CollisionData collision;
+				Object* object0 = dispatch.swapObjects ? batch[i].object1 : batch[i].object0;
+				Object* object1 = dispatch.swapObjects ? batch[i].object0 : batch[i].object1;
+
+				if ((this->*dispatch.function)(collision, object0, object1))
+					collisions.push_back(collision);
+			}
+		}
+	}
+}
+
+void CollisionDetectionNarrow::registerCollisionFunction(ShapeType type0, ShapeType type1, CollisionFunction function)
+{
+	collisionFunctions[type0][type1] = { function, false };
+
+	if (collisionFunctions[type1][type0].function == NULL)
+		collisionFunctions[type1][type0] = { function, true };
+}
+
+float CollisionDetectionNarrow::getSeparation(Object* object0, Object* object1)
+{
+	if (object0->model->shape->type == compound || object1->model->shape->type == compound)
+	{
+		// the closest child decides
+		Object* compoundObject = object0->model->shape->type == compound ? object0 : object1;
+		Object* other = compoundObject == object0 ? object1 : object0;
+		float separation = FLT_MAX;
+
+		for (unsigned i = 0; i < compoundObject->parts.size(); i++)
+		{
+			compoundObject->updatePart(i);
+			separation = std::min(separation, getSeparation(compoundObject->parts[i], other));
+		}
+		return separation;
+	}
+
+	if (object0->model->shape->type == mesh || object1->model->shape->type == mesh)
+	{
+		// the closest triangle near the other object decides
+		Object* meshObject = object0->model->shape->type == mesh ? object0 : object1;
+		Object* other = meshObject == object0 ? object1 : object0;
+		TriangleMesh* triangleMesh = static_cast<TriangleMesh*>(meshObject->model->shape);
+
+		glm::vec3 boundsMin, boundsMax;
+		glm::mat4 transform = getLocalBounds(meshObject, other, boundsMin, boundsMax);
+		triangleMesh->findTriangles(boundsMin, boundsMax, meshTriangles);
+
+		float separation = FLT_MAX;
+		for (auto & triangle : meshTriangles)
+			separation = std::min(separation, getTriangleSeparation(other, transform, triangleMesh->triangles[triangle]));
+
+		return separation;
+	}
+
+	if (object0->model->shape->type == halfSpace || object1->model->shape->type == halfSpace)
+	{
+		// exact distance of the other object from boundary plane
+		Object* halfSpaceObject = object0->model->shape->type == halfSpace ? object0 : object1;
+		Object* other = halfSpaceObject == object0 ? object1 : object0;
+
+		glm::vec3 normal;
+		float offset = getHalfSpacePlane(halfSpaceObject, normal);
+		return getProjectionInterval(other, normal).min - offset;
+	}
+
+	glm::vec3 centers = object0->getPosition() - object1->getPosition();
+
+	if (object0->model->shape->type == sphere && object1->model->shape->type == sphere)
+	{
+		// exact distance of spheres
+		Sphere* sphere0 = static_cast<Sphere*>(object0->model->shape);
+		Sphere* sphere1 = static_cast<Sphere*>(object1->model->shape);
+		return glm::length(centers) - sphere0->radius - sphere1->radius;
+	}
+
+	if (object0->model->shape->type != sphere && object1->model->shape->type != sphere
+		&& selectHullAlgorithm(object0, object1) == gjkEpa)
+	{
+		// exact distance of hulls, zero if they intersect
+		glm::vec3 point0, point1;
+		float distance;
+		return getClosestPoints(object0, object1, point0, point1, distance) ? distance : 0.0f;
+	}
+
+	float separation = -FLT_MAX;
+
+	if (!isZeroVector(centers))
+		separation = getSeparationOnAxis(object0, object1, glm::normalize(centers));
+
+	Object* objects[2] = { object0, object1 };
+	Hull* hulls[2] = { NULL, NULL };
+
+	for (int i = 0; i < 2; i++)
+	{
+		if (objects[i]->model->shape->type == sphere)
+			continue;
+
+		hulls[i] = static_cast<Hull*>(objects[i]->model->shape);
+		glm::mat3 rotationMatrix = objects[i]->getRotationMatrix();
+
+		// projection onto axis covers also the opposite face
+		for (auto & axis : hulls[i]->compact.faceAxes)
+		{
+			separation = std::max(separation, getSeparationOnAxis(object0, object1, rotationMatrix * axis.normal));
+		}
+	}
+
+	if (hulls[0] != NULL && hulls[1] != NULL
+		&& hulls[0]->compact.uniqueEdges.size() * hulls[1]->compact.uniqueEdges.size() <= SEPARATION_MAX_EDGE_AXES)
+	{
+		// edge-edge axes, without them separation of edges passing each other isn't found
+		glm::mat3 rotationMatrix0 = object0->getRotationMatrix();
+		glm::mat3 rotationMatrix1 = object1->getRotationMatrix();
+		const CompactHull& compact0 = hulls[0]->compact;
+		const CompactHull& compact1 = hulls[1]->compact;
+
+		for (auto & direction0 : compact0.uniqueEdgeDirections)
+			for (auto & direction1 : compact1.uniqueEdgeDirections)
+			{
+				glm::vec3 axis = glm::cross(rotationMatrix0 * direction0, rotationMatrix1 * direction1);
+				if (isZeroVector(axis))
+					continue;
+
+				separation = std::max(separation, getSeparationOnAxis(object0, object1, glm::normalize(axis)));
+			}
+	}
+
+	return separation;
+}
+
+bool CollisionDetectionNarrow::findTimeOfImpact(Object* object, Object* other, const glm::vec3& motion, float& time)
+{
+	glm::vec3 endPosition = object->configuration.position;
+	glm::vec3 startPosition = endPosition - motion;
+	// distance can't shrink faster than the moving object moves
+	float motionLength = glm::length(motion);
+
+	// advancement that doesn't converge in given iterations ends with impact at the last conservative time,
+	// separation is only a lower bound, so it converges slowly exactly for fast hulls
+	bool impact = true;
+	time = 0.0f;
+
+	if (motionLength < EPSILON)
+		return false;
+
+	for (unsigned i = 0; i < TIME_OF_IMPACT_MAX_ITERATIONS; i++)
+	{
+		object->configuration.position = startPosition + time * motion;
+		float separation = getSeparation(object, other);
+
+		if (separation < TIME_OF_IMPACT_TOLERANCE)
+		{
+			if (time == 0.0f)
+			{
+				// objects touching at the beginning are left to discrete collision at the end of the motion,
+				// unless the object moves into the other one and could pass through it before the end
+				float probe = std::min(TIME_OF_IMPACT_PROBE_DISTANCE / motionLength, 1.0f);
+				object->configuration.position = startPosition + probe * motion;
+				impact = getSeparation(object, other) < separation - 0.1f * TIME_OF_IMPACT_TOLERANCE;
+			}
+			break;
+		}
+
+		time += separation / motionLength;
+		if (time > 1.0f)
+		{
+			// separation stays positive until the end of the motion
+			impact = false;
+			break;
+		}
+	}
+
+	object->configuration.position = endPosition;
+	time = glm::clamp(time, 0.0f, 1.0f);
+	return impact;
+}
+
+void CollisionDetectionNarrow::setHullAlgorithm(Shape* shape0, Shape* shape1, HullAlgorithm algorithm)
+{
+	auto shapes = std::make_pair(std::min(shape0, shape1), std::max(shape0, shape1));
+
+	if (algorithm == automaticAlgorithm)
+		hullAlgorithms.erase(shapes);
+	else
+		hullAlgorithms[shapes] = algorithm;
+}
+
+bool CollisionDetectionNarrow::getClosestPoints(Object* object0, Object* object1, glm::vec3& point0, glm::vec3& point1, float& distance)
+{
+	GJK gjk(object0, object1);
+	return gjk.computeDistance(distance, point0, point1);
+}
+
+float CollisionDetectionNarrow::getHalfSpacePlane(Object* halfSpaceObject, glm::vec3& normal)
+{
+	HalfSpace* space = static_cast<HalfSpace*>(halfSpaceObject->model->shape);
+
+	normal = halfSpaceObject->getRotationMatrix() * space->normal;
+	return space->offset + glm::dot(normal, halfSpaceObject->getPosition());
+}
+
+HullAlgorithm CollisionDetectionNarrow::selectHullAlgorithm(Object* object0, Object* object1)
+{
+	Shape* shape0 = object0->model->shape;
+	Shape* shape1 = object1->model->shape;
+
+	if (!hullAlgorithms.empty())
+	{
+		auto algorithm = hullAlgorithms.find(std::make_pair(std::min(shape0, shape1), std::max(shape0, shape1)));
+		if (algorithm != hullAlgorithms.end())
+			return algorithm->second;
+	}
+
+	Hull* hull0 = static_cast<Hull*>(shape0);
+	Hull* hull1 = static_cast<Hull*>(shape1);
+
+	// every face normal is tested against all vertices of the other hull, every edge pair gives one more axis
+	const CompactHull& compact0 = hull0->compact;
+	const CompactHull& compact1 = hull1->compact;
+	size_t satCost = compact0.facePlanes.size() * compact1.vertexX.size() + compact1.facePlanes.size() * compact0.vertexX.size()
+		+ compact0.uniqueEdges.size() * compact1.uniqueEdges.size();
+
+	return satCost >= GJK_MIN_SAT_COST ? gjkEpa : separatingAxes;
+}
+
+bool CollisionDetectionNarrow::checkCollisionConvexHulls(CollisionData& collision, Object* object0, Object* object1)
+{
+	if (selectHullAlgorithm(object0, object1) == gjkEpa)
+		return checkCollisionHullsGJK(collision, object0, object1);
+
+	return checkCollisionHulls(collision, object0, object1);
+}
+
+bool CollisionDetectionNarrow::checkCollisionHullsGJK(CollisionData& collision, Object* object0, Object* object1)
+{
+	GJK gjk(object0, object1);
+
+	glm::vec3 point0, point1;
+	float distance;
+
+	if (gjk.computeDistance(distance, point0, point1))
+	{
+		// hulls are separated
+		return false;
+	}
+
+	glm::vec3 collisionNormal;
+	glm::vec3 collisionPoint;
+	float depth;
+
+	if (!gjk.computePenetration(collisionNormal, depth, collisionPoint))
+	{
+		// hulls only touch or polytope is degenerate, SAT handles these cases
+		return checkCollisionHulls(collision, object0, object1);
+	}
+
+	collision.depth = depth;
+
+	collision.object0 = object0;
+	collision.object1 = object1;
+	collision.collisionNormal = collisionNormal;
+	collision.collisionPoint = collisionPoint;
+
+	return true;
+}
+
+bool CollisionDetectionNarrow::checkCollisionHulls(CollisionData& collision, Object * object0, Object * object1)
+{
+	FaceQuery faceQuery0 = testFaceNormals(object0, object1);
+	if (faceQuery0.separationDistance > 0.0f)
+	{
+		// no collision
+		return false;
+	}
+
+	FaceQuery faceQuery1 = testFaceNormals(object1, object0);
+	if (faceQuery1.separationDistance > 0.0f)
+	{
+		// no collision
+		return false;
+	}
+
+	EdgeQuery edgeQuery = testEdgeDirections(object0, object1);
+	if (edgeQuery.separationDistance > 0.0f)
+	{
+		// no collision
+		return false;
+	}
+
+	// list of collision points
+	ClipPolygon collisionPoints;
+
+	Object* queryObject0;
+	Object* queryObject1;
+
+	glm::vec3 collisionPoint;
+
+	float maxFaceSeparation = std::max(faceQuery0.separationDistance, faceQuery1.separationDistance);
+
+	// face contact is preferred, edge contact is used only if edges are clearly less penetrating
+	if (edgeQuery.separationDistance > RELATIVE_EDGE_TOLERANCE * maxFaceSeparation + ABSOLUTE_TOLERANCE)
+	{
+		// edge axis points from the first to the second object
+		glm::vec3 collisionNormal = -edgeQuery.axis;
+		collisionPoint = createEdgeCollision(edgeQuery);
+
+		collision.depth = std::abs(edgeQuery.separationDistance);
+
+		collision.object0 = object0;
+		collision.object1 = object1;
+		collision.collisionNormal = collisionNormal;
+		collision.collisionPoint = collisionPoint;
+
+		return true;
+	}
+
+	FaceQuery query;
+	bool success = false;
+
+	// prefer one face query over other because of coherent contact points from frame to frame
+	if (faceQuery1.separationDistance > RELATIVE_FACE_TOLERANCE * faceQuery0.separationDistance + ABSOLUTE_TOLERANCE)
+	{
+		success = createFaceCollision(faceQuery1, collisionPoints);
+		query = faceQuery1;
+		Hull* hull = static_cast<Hull*>(faceQuery1.object0->model->shape);
+		glm::vec3 collisionAxis = faceQuery1.object0->getRotationMatrix() * hull->compact.facePlanes[faceQuery1.faceIndex].normal;
+		query.axis = collisionAxis;
+	}
+	else
+	{
+		success = createFaceCollision(faceQuery0, collisionPoints);
+		query = faceQuery0;
+		Hull* hull = static_cast<Hull*>(faceQuery0.object0->model->shape);
+		glm::vec3 collisionAxis = faceQuery0.object0->getRotationMatrix() * hull->compact.facePlanes[faceQuery0.faceIndex].normal;
+		query.axis = collisionAxis;
+	}
+	if (!success)
+		return false;
+
+	// couldn't create collision
+	if (collisionPoints.count == 0)
+		return false;
+
+	glm::vec3 sum = glm::vec3(0.0f);
+
+	for (unsigned i = 0; i < collisionPoints.count; i++)
+	{
+		sum += collisionPoints.vertices[i];
+	}
+	collisionPoint = sum / (float)collisionPoints.count;
+
+	glm::vec3 collisionNormal = glm::normalize(query.axis);
+
+	queryObject0 = query.object0;
+	queryObject1 = query.object1;
+
+	float seperationDistance = std::abs(query.separationDistance);
+
+	auto position0 = queryObject0->getPosition();
+	auto position1 = queryObject1->getPosition();
+
+	if (glm::dot(position0 - position1, collisionNormal) < 0.0)
+	{
+		// collision normal doesn't point toward first object, flip it
+		collisionNormal = -collisionNormal;
+	}
+
+	collision.depth = seperationDistance;
+
+	collision.object0 = queryObject0;
+	collision.object1 = queryObject1;
+	collision.collisionNormal = collisionNormal;
+	collision.collisionPoint = collisionPoint;
+
+	return true;
+}
+
+bool CollisionDetectionNarrow::checkCollisionBoxes(CollisionData& collision, Object* object0, Object* object1)
+{
+	WorldBox box0(object0);
+	WorldBox box1(object1);
+	const glm::vec3& extents0 = box0.halfExtents;
+	const glm::vec3& extents1 = box1.halfExtents;
+
+	// sine of angle under which edges are considered parallel
+	constexpr float parallelTolerance = 0.001f;
+
+	// rotation[i][j] is cosine of angle between i-th axis of the first box and j-th axis of the second one,
+	// absolute values are enlarged, so that cross products of nearly parallel axes don't give false separation
+	float rotation[3][3];
+	float absRotation[3][3];
+
+	for (int i = 0; i < 3; i++)
+		for (int j = 0; j < 3; j++)
+		{
+			rotation[i][j] = glm::dot(box0.axes[i], box1.axes[j]);
+			absRotation[i][j] = std::abs(rotation[i][j]) + EPSILON;
+		}
+
+	glm::vec3 centers = box1.center - box0.center;
+	// centre of the second box in frame of the first one
+	glm::vec3 translation = glm::transpose(box0.axes) * centers;
+
+	// face axes of the first box
+	float faceSeparation0 = -FLT_MAX;
+	int faceAxis0 = 0;
+
+	for (int i = 0; i < 3; i++)
+	{
+		float radius1 = extents1[0] * absRotation[i][0] + extents1[1] * absRotation[i][1] + extents1[2] * absRotation[i][2];
+		float separation = std::abs(translation[i]) - extents0[i] - radius1;
+
+		if (separation > 0.0f)
+			return false;
+
+		if (separation > faceSeparation0)
+		{
+			faceSeparation0 = separation;
+			faceAxis0 = i;
+		}
+	}
+
+	// face axes of the second box
+	float faceSeparation1 = -FLT_MAX;
+	int faceAxis1 = 0;
+
+	for (int j = 0; j < 3; j++)
+	{
+		float radius0 = extents0[0] * absRotation[0][j] + extents0[1] * absRotation[1][j] + extents0[2] * absRotation[2][j];
+		float distance = translation[0] * rotation[0][j] + translation[1] * rotation[1][j] + translation[2] * rotation[2][j];
+		float separation = std::abs(distance) - radius0 - extents1[j];
+
+		if (separation > 0.0f)
+			return false;
+
+		if (separation > faceSeparation1)
+		{
+			faceSeparation1 = separation;
+			faceAxis1 = j;
+		}
+	}
+
+	// cross products of edge directions
+	float edgeSeparation = -FLT_MAX;
+	int edgeAxis0 = 0;
+	int edgeAxis1 = 0;
+
+	for (int i = 0; i < 3; i++)
+	{
+		int i1 = (i + 1) % 3;
+		int i2 = (i + 2) % 3;
+
+		for (int j = 0; j < 3; j++)
+		{
+			int j1 = (j + 1) % 3;
+			int j2 = (j + 2) % 3;
+
+			// length of cross product of the axes
+			float length = std::sqrt(std::max(0.0f, 1.0f - rotation[i][j] * rotation[i][j]));
+			if (length < parallelTolerance)
+				continue;
+
+			float radius0 = extents0[i1] * absRotation[i2][j] + extents0[i2] * absRotation[i1][j];
+			float radius1 = extents1[j1] * absRotation[i][j2] + extents1[j2] * absRotation[i][j1];
+			float distance = std::abs(translation[i2] * rotation[i1][j] - translation[i1] * rotation[i2][j]);
+			float separation = (distance - radius0 - radius1) / length;
+
+			if (separation > 0.0f)
+				return false;
+
+			if (separation > edgeSeparation)
+			{
+				edgeSeparation = separation;
+				edgeAxis0 = i;
+				edgeAxis1 = j;
+			}
+		}
+	}
+
+	glm::vec3 collisionNormal;
+	glm::vec3 collisionPoint;
+	float depth;
+
+	// face contact is preferred, edge contact is used only if edges are clearly less penetrating
+	if (edgeSeparation > RELATIVE_EDGE_TOLERANCE * std::max(faceSeparation0, faceSeparation1) + ABSOLUTE_TOLERANCE)
+	{
+		// axis pointing from the first box to the second one
+		glm::vec3 axis = glm::normalize(glm::cross(box0.axes[edgeAxis0], box1.axes[edgeAxis1]));
+		if (glm::dot(axis, centers) < 0.0f)
+			axis = -axis;
+
+		// edges of boxes that are the most extreme toward each other
+		glm::vec3 edgeCenter0 = box0.center;
+		glm::vec3 edgeCenter1 = box1.center;
+
+		for (int k = 0; k < 3; k++)
+		{
+			if (k != edgeAxis0)
+				edgeCenter0 += box0.axes[k] * (glm::dot(box0.axes[k], axis) > 0.0f ? extents0[k] : -extents0[k]);
+			if (k != edgeAxis1)
+				edgeCenter1 += box1.axes[k] * (glm::dot(box1.axes[k], axis) > 0.0f ? -extents1[k] : extents1[k]);
+		}
+
+		glm::vec3 edge0 = box0.axes[edgeAxis0] * extents0[edgeAxis0];
+		glm::vec3 edge1 = box1.axes[edgeAxis1] * extents1[edgeAxis1];
+
+		collisionNormal = -axis;
+		collisionPoint = getSegmentsMidpoint(edgeCenter0 - edge0, edgeCenter0 + edge0, edgeCenter1 - edge1, edgeCenter1 + edge1);
+		depth = std::abs(edgeSeparation);
+	}
+	// prefer face of one box over other because of coherent contact points from frame to frame
+	else if (faceSeparation1 > RELATIVE_FACE_TOLERANCE * faceSeparation0 + ABSOLUTE_TOLERANCE)
+	{
+		// normal of reference face of the second box points toward the first box
+		glm::vec3 normal = box1.axes[faceAxis1];
+		if (glm::dot(normal, centers) > 0.0f)
+			normal = -normal;
+
+		if (!createBoxFaceCollision(box1, faceAxis1, normal, box0, collisionPoint))
+			return false;
+
+		collisionNormal = normal;
+		depth = std::abs(faceSeparation1);
+	}
+	else
+	{
+		glm::vec3 normal = box0.axes[faceAxis0];
+		if (translation[faceAxis0] < 0.0f)
+			normal = -normal;
+
+		if (!createBoxFaceCollision(box0, faceAxis0, normal, box1, collisionPoint))
+			return false;
+
+		collisionNormal = -normal;
+		depth = std::abs(faceSeparation0);
+	}
+
+	collision.depth = depth;
+
+	collision.object0 = object0;
+	collision.object1 = object1;
+	collision.collisionNormal = collisionNormal;
+	collision.collisionPoint = collisionPoint;
+
+	return true;
+}
+
+bool CollisionDetectionNarrow::createBoxFaceCollision(const WorldBox& reference, int axis, const glm::vec3& normal, const WorldBox& incident, glm::vec3& contact)
+{
+	// incident face is face of incident box most antiparallel to reference normal
+	int incidentAxis = 0;
+	float maximalDot = -1.0f;
+
+	for (int k = 0; k < 3; k++)
+	{
+		float dot = std::abs(glm::dot(incident.axes[k], normal));
+		if (dot > maximalDot)
+		{
+			maximalDot = dot;
+			incidentAxis = k;
+		}
+	}
+
+	glm::vec3 incidentNormal = incident.axes[incidentAxis];
+	if (glm::dot(incidentNormal, normal) > 0.0f)
+		incidentNormal = -incidentNormal;
+
+	glm::vec3 faceCenter = incident.center + incidentNormal * incident.halfExtents[incidentAxis];
+	glm::vec3 u = incident.axes[(incidentAxis + 1) % 3] * incident.halfExtents[(incidentAxis + 1) % 3];
+	glm::vec3 v = incident.axes[(incidentAxis + 2) % 3] * incident.halfExtents[(incidentAxis + 2) % 3];
+
+	// incident face is clipped in frame of the reference box, where side planes are aligned with axes;
+	// quad clipped by 4 planes has at most 8 vertices
+	glm::mat3 inverseAxes = glm::transpose(reference.axes);
+	glm::vec3 polygon[8];
+	glm::vec3 clipped[8];
+	unsigned count = 4;
+
+	polygon[0] = inverseAxes * (faceCenter + u + v - reference.center);
+	polygon[1] = inverseAxes * (faceCenter - u + v - reference.center);
+	polygon[2] = inverseAxes * (faceCenter - u - v - reference.center);
+	polygon[3] = inverseAxes * (faceCenter + u - v - reference.center);
+
+	for (int k = 0; k < 3; k++)
+	{
+		if (k == axis)
+			continue;
+
+		for (int side = 0; side < 2; side++)
+		{
+			float sign = side == 0 ? 1.0f : -1.0f;
+			float extent = reference.halfExtents[k];
+			unsigned clippedCount = 0;
+
+			// tail vertex of an edge
+			glm::vec3 vertex1 = polygon[count - 1];
+			float distance1 = sign * vertex1[k] - extent;
+
+			for (unsigned i = 0; i < count; i++)
+			{
+				// head vertex of an edge
+				glm::vec3 vertex2 = polygon[i];
+				float distance2 = sign * vertex2[k] - extent;
+
+				if ((distance1 <= 0.0f) != (distance2 <= 0.0f))
+				{
+					// edge crosses side plane, keep intersection point
+					float fraction = distance1 / (distance1 - distance2);
+					clipped[clippedCount++] = vertex1 + fraction * (vertex2 - vertex1);
+				}
+				if (distance2 <= 0.0f)
+				{
+					clipped[clippedCount++] = vertex2;
+				}
+
+				vertex1 = vertex2;
+				distance1 = distance2;
+			}
+
+			if (clippedCount == 0)
+				return false;
+
+			count = clippedCount;
+			std::copy(clipped, clipped + count, polygon);
+		}
+	}
+
+	float faceSign = glm::dot(reference.axes[axis], normal) > 0.0f ? 1.0f : -1.0f;
+	float faceOffset = reference.halfExtents[axis];
+	glm::vec3 sum = glm::vec3(0.0f);
+	unsigned contactCount = 0;
+
+	for (unsigned i = 0; i < count; i++)
+	{
+		// keep only vertices that are below reference face
+		if (faceSign * polygon[i][axis] < faceOffset)
+		{
+			// move contact point onto reference face
+			glm::vec3 contactPoint = polygon[i];
+			contactPoint[axis] = faceSign * faceOffset;
+			sum += reference.axes * contactPoint + reference.center;
+			contactCount++;
+		}
+	}
+
+	if (contactCount == 0)
+		return false;
+
+	contact = sum / (float)contactCount;
+	return true;
+}
+
+bool CollisionDetectionNarrow::checkCollisionBoxSphere(CollisionData& collision, Object* boxObject, Object* sphereObject)
+{
+	WorldBox box(boxObject);
+	Sphere* sphere = static_cast<Sphere*>(sphereObject->model->shape);
+	float radius = sphere->radius;
+
+	// sphere centre in frame of the box
+	glm::vec3 center = glm::transpose(box.axes) * (sphereObject->getPosition() - box.center);
+	glm::vec3 closest = glm::clamp(center, -box.halfExtents, box.halfExtents);
+
+	// normal in frame of the box, points from sphere toward box
+	glm::vec3 localNormal = glm::vec3(0.0f);
+	float depth;
+
+	if (closest == center)
+	{
+		// centre is inside the box, sphere is pushed out through the nearest face
+		int axis = 0;
+		float minimalDistance = FLT_MAX;
+
+		for (int k = 0; k < 3; k++)
+		{
+			float distance = box.halfExtents[k] - std::abs(center[k]);
+			if (distance < minimalDistance)
+			{
+				minimalDistance = distance;
+				axis = k;
+			}
+		}
+
+		localNormal[axis] = center[axis] > 0.0f ? -1.0f : 1.0f;
+		depth = radius + minimalDistance;
+	}
+	else
+	{
+		glm::vec3 difference = center - closest;
+		float distance = glm::length(difference);
+
+		if (distance > radius)
+			return false;
+
+		localNormal = -difference / distance;
+		depth = radius - distance;
+	}
+
+	glm::vec3 collisionNormal = box.axes * localNormal;
+
+	collision.depth = depth;
+
+	glm::vec3 collisionPoint = sphereObject->getPosition() + collisionNormal * radius;
+
+	collision.object0 = boxObject;
+	collision.object1 = sphereObject;
+	collision.collisionNormal = collisionNormal;
+	collision.collisionPoint = collisionPoint;
+
+	return true;
+}
+
+bool CollisionDetectionNarrow::checkCollisionHalfSpaceSphere(CollisionData& collision, Object* halfSpaceObject, Object* sphereObject)
+{
+	HalfSpace* space = static_cast<HalfSpace*>(halfSpaceObject->model->shape);
+	Sphere* sphere = static_cast<Sphere*>(sphereObject->model->shape);
+
+	glm::vec3 normal;
+	float offset = getHalfSpacePlane(halfSpaceObject, normal);
+
+	glm::vec3 center = sphereObject->getPosition();
+	float distance = glm::dot(normal, center) - offset;
+
+	if (distance > sphere->radius)
+		return false;
+
+	// sphere touches bounded half-space also when only its side reaches over the edge
+	glm::vec3 localCenter = glm::transpose(halfSpaceObject->getRotationMatrix()) * (center - halfSpaceObject->getPosition());
+	if (!space->isWithinBounds(localCenter, sphere->radius))
+		return false;
+
+	// collision normal points toward half-space
+	glm::vec3 collisionNormal = -normal;
+
+	collision.depth = sphere->radius - distance;
+
+	collision.object0 = halfSpaceObject;
+	collision.object1 = sphereObject;
+	collision.collisionNormal = collisionNormal;
+	collision.collisionPoint = sphereObject->getPosition() + collisionNormal * sphere->radius;
+
+	return true;
+}
+
+bool CollisionDetectionNarrow::checkCollisionHalfSpaceHull(CollisionData& collision, Object* halfSpaceObject, Object* hullObject)
+{
+	HalfSpace* space = static_cast<HalfSpace*>(halfSpaceObject->model->shape);
+	Hull* hull = static_cast<Hull*>(hullObject->model->shape);
+	const CompactHull& compact = hull->compact;
+
+	glm::vec3 normal;
+	float offset = getHalfSpacePlane(halfSpaceObject, normal);
+
+	// boundary plane in local space of the hull
+	glm::mat3 rotationMatrix = hullObject->getRotationMatrix();
+	glm::vec3 localNormal = glm::transpose(rotationMatrix) * normal;
+	float localOffset = offset - glm::dot(normal, hullObject->getPosition());
+
+	unsigned deepestVertex = hull->findSupportVertex(-localNormal, hullObject->supportVertices);
+	float depth = localOffset - glm::dot(localNormal, compact.getVertex(deepestVertex));
+
+	if (depth < 0.0f)
+		return false;
+
+	uint16_t contactVertices[MAX_CONTACT_VERTICES];
+	unsigned contactCount = findVerticesBelowPlane(compact, localNormal, localOffset, deepestVertex, contactVertices);
+
+	// vertex only touching the plane is the deepest one
+	if (contactCount == 0)
+		contactVertices[contactCount++] = deepestVertex;
+
+	// contact points outside of bounds of bounded half-space are dropped, depth is given by the deepest of the rest
+	glm::mat3 inverseSpaceRotation = glm::transpose(halfSpaceObject->getRotationMatrix());
+	glm::vec3 sum = glm::vec3(0.0f);
+	unsigned keptCount = 0;
+	depth = -FLT_MAX;
+
+	for (unsigned i = 0; i < contactCount; i++)
+	{
+		// contact points are moved onto the plane
+		glm::vec3 vertex = compact.getVertex(contactVertices[i]);
+		float vertexDepth = localOffset - glm::dot(localNormal, vertex);
+		glm::vec3 point = rotationMatrix * (vertex + localNormal * vertexDepth) + hullObject->getPosition();
+
+		if (space->bounded && !space->isWithinBounds(inverseSpaceRotation * (point - halfSpaceObject->getPosition())))
+			continue;
+
+		sum += point;
+		depth = std::max(depth, vertexDepth);
+		keptCount++;
+	}
+
+	if (keptCount == 0)
+		return false;
+
+	glm::vec3 collisionPoint = sum / (float)keptCount;
+
+	// collision normal points toward half-space
+	glm::vec3 collisionNormal = -normal;
+
+	collision.depth = depth;
+
+	collision.object0 = halfSpaceObject;
+	collision.object1 = hullObject;
+	collision.collisionNormal = collisionNormal;
+	collision.collisionPoint = collisionPoint;
+
+	return true;
+}
+
+bool CollisionDetectionNarrow::checkCollisionCompound(CollisionData& collision, Object* compoundObject, Object* other)
+{
+	Compound* shape = static_cast<Compound*>(compoundObject->model->shape);
+	glm::vec3 boundsMin = glm::vec3(-FLT_MAX);
+	glm::vec3 boundsMax = glm::vec3(FLT_MAX);
+
+	if (other->model->shape->type != halfSpace)
+		getLocalBounds(compoundObject, other, boundsMin, boundsMax);
+
+	uint16_t found[MAX_COMPOUND_CHILDREN];
+	unsigned count = shape->findChildren(boundsMin, boundsMax, found);
+
+	glm::vec3 normalSum = glm::vec3(0.0f);
+	glm::vec3 pointSum = glm::vec3(0.0f);
+	float depth = 0.0f;
+	unsigned contacts = 0;
+
+	for (unsigned i = 0; i < count; i++)
+	{
+		compoundObject->updatePart(found[i]);
+		Object* part = compoundObject->parts[found[i]];
+
+		CollisionData partCollision;
+		if (!checkCollision(partCollision, part, other))
+			continue;
+
+		// the deepest child decides how far the whole compound is pushed out
+		depth = std::max(depth, partCollision.depth);
+
+		// normal must point from the other object to the compound
+		normalSum += partCollision.object0 == part ? partCollision.collisionNormal : -partCollision.collisionNormal;
+		pointSum += partCollision.collisionPoint;
+		contacts++;
+	}
+
+	if (contacts == 0 || isZeroVector(normalSum))
+		return false;
+
+	collision.object0 = compoundObject;
+	collision.object1 = other;
+	collision.collisionNormal = glm::normalize(normalSum);
+	collision.collisionPoint = pointSum / (float)contacts;
+	collision.depth = depth;
+
+	return true;
+}
+
+bool CollisionDetectionNarrow::checkCollisionMeshSphere(CollisionData& collision, Object* meshObject, Object* sphereObject)
+{
+	TriangleMesh* triangleMesh = static_cast<TriangleMesh*>(meshObject->model->shape);
+	float radius = static_cast<Sphere*>(sphereObject->model->shape)->radius;
+
+	glm::vec3 boundsMin, boundsMax;
+	glm::vec3 center = getLocalBounds(meshObject, sphereObject, boundsMin, boundsMax)[3];
+	triangleMesh->findTriangles(boundsMin, boundsMax, meshTriangles);
+
+	glm::vec3 normalSum = glm::vec3(0.0f);
+	glm::vec3 pointSum = glm::vec3(0.0f);
+	float depth = 0.0f;
+	unsigned contacts = 0;
+
+	// triangles are tested in local space of the mesh
+	for (auto & index : meshTriangles)
+	{
+		const MeshTriangle& triangle = triangleMesh->triangles[index];
+
+		// triangles are one-sided, sphere whose centre is behind triangle is pushed out by its neighbours
+		if (glm::dot(triangle.normal, center - triangle.vertices[0]) < 0.0f)
+			continue;
+
+		glm::vec3 closest = TriangleMesh::findClosestPoint(triangle.vertices, center);
+		float distance = glm::length(center - closest);
+
+		if (distance > radius)
+			continue;
+
+		normalSum += distance > EPSILON ? (center - closest) / distance : triangle.normal;
+		pointSum += closest;
+		depth = std::max(depth, radius - distance);
+		contacts++;
+	}
+
+	if (contacts == 0 || isZeroVector(normalSum))
+		return false;
+
+	glm::mat3 rotationMatrix = meshObject->getRotationMatrix();
+	// collision normal points toward mesh
+	glm::vec3 collisionNormal = -glm::normalize(rotationMatrix * normalSum);
+
+	collision.depth = depth;
+
+	collision.object0 = meshObject;
+	collision.object1 = sphereObject;
+	collision.collisionNormal = collisionNormal;
+	collision.collisionPoint = rotationMatrix * (pointSum / (float)contacts) + meshObject->getPosition();
+
+	return true;
+}
+
+bool CollisionDetectionNarrow::checkCollisionMeshHull(CollisionData& collision, Object* meshObject, Object* hullObject)
+{
+	TriangleMesh* triangleMesh = static_cast<TriangleMesh*>(meshObject->model->shape);
+	Hull* hull = static_cast<Hull*>(hullObject->model->shape);
+
+	glm::vec3 boundsMin, boundsMax;
+	glm::mat4 transform = getLocalBounds(meshObject, hullObject, boundsMin, boundsMax);
+	triangleMesh->findTriangles(boundsMin, boundsMax, meshTriangles);
+
+	glm::vec3 normalSum = glm::vec3(0.0f);
+	glm::vec3 pointSum = glm::vec3(0.0f);
+	float depth = 0.0f;
+	unsigned contacts = 0;
+
+	// all triangles are tested at the same position of the hull, so that its contact covers all of them
+	for (auto & index : meshTriangles)
+	{
+		glm::vec3 normal, point;
+		float triangleDepth;
+
+		if (!findTriangleContact(hull, transform, hullObject->supportVertices, triangleMesh->triangles[index], normal, triangleDepth, point))
+			continue;
+
+		normalSum += normal;
+		pointSum += point;
+		depth = std::max(depth, triangleDepth);
+		contacts++;
+	}
+
+	if (contacts == 0 || isZeroVector(normalSum))
+		return false;
+
+	glm::mat3 rotationMatrix = meshObject->getRotationMatrix();
+	// collision normal points toward mesh
+	glm::vec3 collisionNormal = -glm::normalize(rotationMatrix * normalSum);
+
+	collision.depth = depth;
+
+	collision.object0 = meshObject;
+	collision.object1 = hullObject;
+	collision.collisionNormal = collisionNormal;
+	collision.collisionPoint = rotationMatrix * (pointSum / (float)contacts) + meshObject->getPosition();
+
+	return true;
+}
+
+bool CollisionDetectionNarrow::findTriangleContact(Hull* hull, const glm::mat4& transform, uint16_t* supportCache, const MeshTriangle& triangle,
+	glm::vec3& normal, float& depth, glm::vec3& point)
+{
+	const CompactHull& compact = hull->compact;
+	const glm::vec3* vertices = triangle.vertices;
+	glm::mat3 rotationMatrix = glm::mat3(transform);
+	glm::vec3 position = glm::vec3(transform[3]);
+
+	float offset = glm::dot(triangle.normal, vertices[0]);
+
+	// triangles are one-sided, hull whose centre is behind triangle is pushed out by its neighbours
+	if (glm::dot(triangle.normal, position) < offset)
+		return false;
+
+	interval hullInterval = hull->getProjectionInterval(triangle.normal, transform, supportCache);
+	if (hullInterval.min > offset)
+		return false;
+
+	normal = triangle.normal;
+	depth = offset - hullInterval.min;
+
+	// edge of the hull and edge of the triangle whose cross product is the best axis, if it is such one
+	int hullEdge = -1;
+	int triangleEdge = -1;
+
+	// tests axis, returns false if it separates objects; axis replaces the best one if its depth is smaller by tolerance
+	auto testAxis = [&](const glm::vec3& axis, float tolerance, bool& better) -> bool
+	{
+		interval hullProjection = hull->getProjectionInterval(axis, transform, supportCache);
+		interval triangleProjection = { FLT_MAX, -FLT_MAX };
+
+		for (int i = 0; i < 3; i++)
+		{
+			float projection = glm::dot(axis, vertices[i]);
+			triangleProjection.min = std::min(triangleProjection.min, projection);
+			triangleProjection.max = std::max(triangleProjection.max, projection);
+		}
+
+		better = false;
+		if (!overlap(hullProjection, triangleProjection))
+			return false;
+
+		// hull is pushed to the side on which it overlaps less
+		float positiveDepth = triangleProjection.max - hullProjection.min;
+		float negativeDepth = hullProjection.max - triangleProjection.min;
+		float axisDepth = std::min(positiveDepth, negativeDepth);
+
+		// normal of the triangle is preferred, so that objects resting on mesh aren't pushed along it
+		if (axisDepth + ABSOLUTE_TOLERANCE < tolerance * depth)
+		{
+			depth = axisDepth;
+			normal = positiveDepth <= negativeDepth ? axis : -axis;
+			better = true;
+		}
+		return true;
+	};
+
+	bool better;
+
+	for (auto & axis : compact.faceAxes)
+	{
+		if (!testAxis(rotationMatrix * axis.normal, RELATIVE_FACE_TOLERANCE, better))
+			return false;
+	}
+
+	if (compact.uniqueEdges.size() * 3 <= SEPARATION_MAX_EDGE_AXES)
+	{
+		for (unsigned i = 0; i < compact.uniqueEdges.size(); i++)
+		{
+			for (int j = 0; j < 3; j++)
+			{
+				glm::vec3 axis = glm::cross(rotationMatrix * compact.uniqueEdgeDirections[i], vertices[(j + 1) % 3] - vertices[j]);
+				if (isZeroVector(axis))
+					continue;
+
+				if (!testAxis(glm::normalize(axis), RELATIVE_EDGE_TOLERANCE, better))
+					return false;
+
+				if (better)
+				{
+					hullEdge = compact.uniqueEdges[i];
+					triangleEdge = j;
+				}
+			}
+		}
+	}
+
+	if (hullEdge >= 0)
+	{
+		glm::vec3 tail = transform * glm::vec4(compact.getVertex(compact.edges[hullEdge].origin), 1.0f);
+		glm::vec3 head = transform * glm::vec4(compact.getVertex(compact.getHead(hullEdge)), 1.0f);
+		point = getSegmentsMidpoint(tail, head, vertices[triangleEdge], vertices[(triangleEdge + 1) % 3]);
+		return true;
+	}
+
+	// contact is average of hull vertices below the triangle and triangle vertices inside the hull
+	glm::vec3 sum = glm::vec3(0.0f);
+	unsigned count = 0;
+
+	glm::vec3 localNormal = glm::transpose(rotationMatrix) * triangle.normal;
+	float localOffset = offset - glm::dot(triangle.normal, position);
+	unsigned deepestVertex = hull->findSupportVertex(-localNormal, supportCache);
+
+	uint16_t belowVertices[MAX_CONTACT_VERTICES];
+	unsigned belowCount = findVerticesBelowPlane(compact, localNormal, localOffset, deepestVertex, belowVertices);
+
+	for (unsigned i = 0; i < belowCount; i++)
+	{
+		glm::vec3 vertex = transform * glm::vec4(compact.getVertex(belowVertices[i]), 1.0f);
+		if (!TriangleMesh::isAboveTriangle(vertices, triangle.normal, vertex))
+			continue;
+
+		// contact points are moved onto the triangle
+		sum += vertex + triangle.normal * (offset - glm::dot(triangle.normal, vertex));
+		count++;
+	}
+
+	for (int i = 0; i < 3; i++)
+	{
+		glm::vec3 localVertex = glm::transpose(rotationMatrix) * (vertices[i] - position);
+		bool inside = true;
+
+		for (auto & plane : compact.facePlanes)
+		{
+			if (glm::dot(plane.normal, localVertex) - plane.d > LINEAR_SLOP)
+			{
+				inside = false;
+				break;
+			}
+		}
+
+		if (inside)
+		{
+			sum += vertices[i];
+			count++;
+		}
+	}
+
+	if (count == 0)
+	{
+		// hull only touches the triangle
+		sum = transform * glm::vec4(compact.getVertex(hull->findSupportVertex(glm::transpose(rotationMatrix) * -normal, supportCache)), 1.0f);
+		count = 1;
+	}
+
+	point = sum / (float)count;
+	return true;
+}
+
+float CollisionDetectionNarrow::getTriangleSeparation(Object* object, const glm::mat4& transform, const MeshTriangle& triangle)
+{
+	glm::vec3 position = glm::vec3(transform[3]);
+
+	if (object->model->shape->type == sphere)
+	{
+		float radius = static_cast<Sphere*>(object->model->shape)->radius;
+		return glm::length(position - TriangleMesh::findClosestPoint(triangle.vertices, position)) - radius;
+	}
+
+	Hull* hull = static_cast<Hull*>(object->model->shape);
+	glm::mat3 rotationMatrix = glm::mat3(transform);
+
+	auto getSeparationOnTriangleAxis = [&](const glm::vec3& axis) -> float
+	{
+		interval hullProjection = hull->getProjectionInterval(axis, transform, object->supportVertices);
+		interval triangleProjection = { FLT_MAX, -FLT_MAX };
+
+		for (auto & vertex : triangle.vertices)
+		{
+			float projection = glm::dot(axis, vertex);
+			triangleProjection.min = std::min(triangleProjection.min, projection);
+			triangleProjection.max = std::max(triangleProjection.max, projection);
+		}
+
+		return std::max(hullProjection.min - triangleProjection.max, triangleProjection.min - hullProjection.max);
+	};
+
+	float separation = getSeparationOnTriangleAxis(triangle.normal);
+
+	for (auto & axis : hull->compact.faceAxes)
+		separation = std::max(separation, getSeparationOnTriangleAxis(rotationMatrix * axis.normal));
+
+	return separation;
+}
+
+glm::mat4 CollisionDetectionNarrow::getLocalBounds(Object* object, Object* other, glm::vec3& min, glm::vec3& max)
+{
+	glm::mat3 inverseRotation = glm::transpose(object->getRotationMatrix());
+
+	// AABB of the other object is rotated into local space of the object, extents are projected onto its axes
+	glm::vec3 center = inverseRotation * (0.5f * (other->aabb->min + other->aabb->max) - object->getPosition());
+	glm::vec3 worldHalfExtents = 0.5f * (other->aabb->max - other->aabb->min);
+	glm::vec3 halfExtents = glm::abs(inverseRotation[0]) * worldHalfExtents.x
+		+ glm::abs(inverseRotation[1]) * worldHalfExtents.y
+		+ glm::abs(inverseRotation[2]) * worldHalfExtents.z;
+
+	min = center - halfExtents;
+	max = center + halfExtents;
+
+	glm::mat4 transform = glm::mat4(inverseRotation * other->getRotationMatrix());
+	transform[3] = glm::vec4(inverseRotation * (other->getPosition() - object->getPosition()), 1.0f);
+	return transform;
+}
+
+unsigned CollisionDetectionNarrow::findVerticesBelowPlane(const CompactHull& compact, const glm::vec3& normal, float offset, unsigned deepestVertex, uint16_t* found)
+{
+	unsigned count = 0;
+
+	if (!compact.closed)
+	{
+		for (unsigned i = 0; i < compact.vertexX.size() && count < MAX_CONTACT_VERTICES; i++)
+		{
+			if (glm::dot(normal, compact.getVertex(i)) < offset)
+				found[count++] = i;
+		}
+		return count;
+	}
+
+	if (glm::dot(normal, compact.getVertex(deepestVertex)) >= offset)
+		return 0;
+
+	// vertices below the plane form connected part of closed hull, so they are found from the deepest one
+	found[count++] = deepestVertex;
+
+	for (unsigned i = 0; i < count && count < MAX_CONTACT_VERTICES; i++)
+	{
+		unsigned firstEdge = compact.vertexEdges[found[i]];
+		unsigned edge = firstEdge;
+
+		do
+		{
+			unsigned head = compact.getHead(edge);
+
+			if (glm::dot(normal, compact.getVertex(head)) < offset
+				&& std::find(found, found + count, head) == found + count)
+			{
+				found[count++] = head;
+				if (count == MAX_CONTACT_VERTICES)
+					break;
+			}
+			edge = compact.edges[compact.edges[edge].twin].next;
+		} while (edge != firstEdge);
+	}
+
+	return count;
+}
+
+bool CollisionDetectionNarrow::checkCollisionSpheres(CollisionData& collision, Object* object0, Object* object1)
+{
+	Sphere* sphere0 = static_cast<Sphere*>(object0->model->shape);
+	Sphere* sphere1 = static_cast<Sphere*>(object1->model->shape);
+
+	glm::vec3 position0 = object0->configuration.position;
+	glm::vec3 position1 = object1->configuration.position;
+
+	float radius0 = sphere0->radius;
+	float radius1 = sphere1->radius;
+
+	float distance = glm::length(position1 - position0);
+	float sumOfRadii = radius0 + radius1;
+
+	float separation = distance - sumOfRadii;
+
+	if (separation > 0.0f)
+	{
+		// no separation
+		return false;
+	}
+
+	glm::vec3 collisionNormal;
+	if (position0 == position1)
+	{
+		// spheres are coincident
+		collisionNormal = glm::vec3(0.0f, 1.0f, 0.0f);
+	}
+	else
+	{
+		collisionNormal = glm::normalize(position0 - position1);
+	}
+
+	separation = std::abs(separation);
+	
+	collision.depth = separation;
+
+	glm::vec3 collisionPoint = object1->getPosition() + collisionNormal * sphere1->radius;
+
+	collision.object0 = object0;
+	collision.object1 = object1;
+	collision.collisionNormal = collisionNormal;
+	collision.collisionPoint = collisionPoint;
+
+	return true;
+}
+
+bool CollisionDetectionNarrow::checkCollisionPlaneSphere(CollisionData& collision, Object* planeObject, Object* sphereObject)
+{
+	PlaneShape* plane = static_cast<PlaneShape*>(planeObject->model->shape);
+	Sphere* sphere = static_cast<Sphere*>(sphereObject->model->shape);
+
+	glm::mat4 transformationMatrix = planeObject->getModelMatrix();
+	glm::mat3 rotationMatrix = planeObject->getRotationMatrix();
+
+	const CompactHull& compact = plane->compact;
+	unsigned firstEdge = compact.faceEdges[0];
+	unsigned edge = firstEdge;
+
+	// check if sphere is out of plane
+	do
+	{
+		unsigned nextEdge = compact.edges[edge].next;
+		heVertex sidePlaneVertex = { glm::vec3(transformationMatrix * glm::vec4(compact.getVertex(compact.getHead(nextEdge)), 1.0f)) };
+
+		// normal of side plane of the next edge is direction vector of this edge
+		glm::vec3 sidePlaneNormal = rotationMatrix * glm::normalize(compact.getEdgeVector(edge));
+
+		Plane sidePlane = { &sidePlaneVertex, sidePlaneNormal };
+
+		heVertex supportPoint = { sphere->getSupport(-sidePlane.normal, sphereObject->getPosition()) };
+		float distance = supportPoint.distanceFromPlane(sidePlane);
+
+		if (distance > 0.0f)
+		{
+			return false;
+		}
+
+		edge = nextEdge;
+	} while (edge != firstEdge);
+
+	return checkCollisionHullSphere(collision, planeObject, sphereObject);
+}
+
+
+bool CollisionDetectionNarrow::checkCollisionHullSphere(CollisionData& collision, Object* hullObject, Object* sphereObject)
+{
+	Hull* hull = static_cast<Hull*>(hullObject->model->shape);
+	Sphere* sphere = static_cast<Sphere*>(sphereObject->model->shape);
+	const CompactHull& compact = hull->compact;
+
+	glm::mat3 rotationMatrix = hullObject->getRotationMatrix();
+
+	// sphere centre in local space of the hull, whole test is done there
+	glm::vec3 center = glm::transpose(rotationMatrix) * (sphereObject->getPosition() - hullObject->getPosition());
+	float radius = sphere->radius;
+
+	unsigned faceCount = compact.facePlanes.size();
+	// cached face is kept for each pair, sphere touching several hulls doesn't overwrite it
+	unsigned slot = 0;
+	while (slot < CLOSEST_FACE_SLOTS && sphereObject->closestFaceHulls[slot] != hullObject)
+		slot++;
+
+	if (slot == CLOSEST_FACE_SLOTS)
+	{
+		slot = sphereObject->nextClosestFaceSlot;
+		sphereObject->nextClosestFaceSlot = (slot + 1) % CLOSEST_FACE_SLOTS;
+		sphereObject->closestFaceHulls[slot] = hullObject;
+		sphereObject->closestFaces[slot] = NO_INDEX;
+	}
+
+	uint16_t& cachedFace = sphereObject->closestFaces[slot];
+	unsigned closestFace = cachedFace;
+
+	// point of the hull closest to the centre, valid if the centre is outside of the hull
+	glm::vec3 closestPoint;
+	bool outside = false;
+
+	if (closestFace < faceCount)
+	{
+		// face closest in the last test, if the centre is still above its interior, no other face has to be tested
+		const Plane& plane = compact.facePlanes[closestFace];
+		float distance = glm::dot(plane.normal, center) - plane.d;
+
+		if (distance > radius)
+		{
+			// face plane separates objects
+			return false;
+		}
+
+		outside = distance > 0.0f && findClosestPointOnFace(compact, closestFace, center, closestPoint);
+	}
+
+	glm::vec3 localNormal;
+	float depth;
+
+	if (!outside)
+	{
+		float maxDistance = -FLT_MAX;
+		unsigned nearestFace = 0;
+
+		for (unsigned i = 0; i < faceCount; i++)
+		{
+			const Plane& plane = compact.facePlanes[i];
+			float distance = glm::dot(plane.normal, center) - plane.d;
+
+			if (distance > radius)
+			{
+				// face plane separates objects
+				cachedFace = i;
+				return false;
+			}
+
+			if (distance > maxDistance)
+			{
+				maxDistance = distance;
+				nearestFace = i;
+			}
+		}
+
+		if (maxDistance <= 0.0f)
+		{
+			// centre is inside the hull, sphere is pushed out through the nearest face
+			localNormal = -compact.facePlanes[nearestFace].normal;
+			depth = radius - maxDistance;
+			cachedFace = nearestFace;
+		}
+		else
+		{
+			// closest point lies on one of faces facing the centre
+			float minimalDistance = FLT_MAX;
+
+			for (unsigned i = 0; i < faceCount; i++)
+			{
+				const Plane& plane = compact.facePlanes[i];
+				if (glm::dot(plane.normal, center) - plane.d <= 0.0f)
+					continue;
+
+				glm::vec3 point;
+				bool inside = findClosestPointOnFace(compact, i, center, point);
+				float distance = glm::dot(point - center, point - center);
+
+				if (distance < minimalDistance)
+				{
+					minimalDistance = distance;
+					closestPoint = point;
+					closestFace = i;
+				}
+
+				// centre lies in Voronoi region of the face
+				if (inside)
+					break;
+			}
+
+			cachedFace = closestFace;
+			outside = true;
+		}
+	}
+
+	if (outside)
+	{
+		glm::vec3 difference = closestPoint - center;
+		float distance = glm::length(difference);
+
+		if (distance > radius)
+			return false;
+
+		// centre lying on the surface is pushed out along normal of the closest face
+		localNormal = distance > EPSILON ? difference / distance : -compact.facePlanes[cachedFace].normal;
+		depth = radius - distance;
+	}
+
+	glm::vec3 collisionNormal = rotationMatrix * localNormal;
+
+	collision.depth = depth;
+
+	glm::vec3 collisionPoint = sphereObject->getPosition() + collisionNormal * sphere->radius;
+
+	collision.object0 = hullObject;
+	collision.object1 = sphereObject;
+	collision.collisionNormal = collisionNormal;
+	collision.collisionPoint = collisionPoint;
+
+	return true;
+}
+
+bool CollisionDetectionNarrow::findClosestPointOnFace(const CompactHull& compact, unsigned face, const glm::vec3& point, glm::vec3& closest)
+{
+	const Plane& plane = compact.facePlanes[face];
+	glm::vec3 projection = point - plane.normal * (glm::dot(plane.normal, point) - plane.d);
+
+	unsigned firstEdge = compact.faceEdges[face];
+	unsigned edge = firstEdge;
+	bool inside = true;
+
+	// projection is inside the face if it is behind side planes of all edges
+	do
+	{
+		glm::vec3 sideNormal = glm::cross(compact.getEdgeVector(edge), plane.normal);
+		if (glm::dot(sideNormal, projection - compact.getVertex(compact.edges[edge].origin)) > 0.0f)
+		{
+			inside = false;
+			break;
+		}
+		edge = compact.edges[edge].next;
+	} while (edge != firstEdge);
+
+	if (inside)
+	{
+		closest = projection;
+		return true;
+	}
+
+	// closest point lies on boundary of the face
+	float minimalDistance = FLT_MAX;
+	edge = firstEdge;
+
+	do
+	{
+		glm::vec3 tail = compact.getVertex(compact.edges[edge].origin);
+		glm::vec3 edgeVector = compact.getEdgeVector(edge);
+		float fraction = glm::clamp(glm::dot(point - tail, edgeVector) / glm::dot(edgeVector, edgeVector), 0.0f, 1.0f);
+		glm::vec3 edgePoint = tail + fraction * edgeVector;
+		float distance = glm::dot(point - edgePoint, point - edgePoint);
+
+		if (distance < minimalDistance)
+		{
+			minimalDistance = distance;
+			closest = edgePoint;
+		}
+		edge = compact.edges[edge].next;
+	} while (edge != firstEdge);
+
+	return false;
+}
+
+void CollisionDetectionNarrow::findSeparatedSpheres(const ObjectPair* pairs, unsigned count, uint32_t* separated)
+{
+	// vectors between centres and sums of radii in structure of arrays, all lanes are computed by the same instructions
+	float x[BATCH_SIZE];
+	float y[BATCH_SIZE];
+	float z[BATCH_SIZE];
+	float reach[BATCH_SIZE];
+
+	for (unsigned i = 0; i < BATCH_SIZE; i++)
+	{
+		if (i >= count)
+		{
+			// unused lane
+			x[i] = y[i] = z[i] = reach[i] = 0.0f;
+			continue;
+		}
+
+		const glm::vec3& center0 = pairs[i].object0->configuration.position;
+		const glm::vec3& center1 = pairs[i].object1->configuration.position;
+
+		x[i] = center1.x - center0.x;
+		y[i] = center1.y - center0.y;
+		z[i] = center1.z - center0.z;
+		reach[i] = static_cast<Sphere*>(pairs[i].object0->model->shape)->radius
+			+ static_cast<Sphere*>(pairs[i].object1->model->shape)->radius;
+	}
+
+	for (unsigned i = 0; i < BATCH_SIZE; i++)
+	{
+		float margin = reach[i] * (1.0f + BATCH_MARGIN);
+		separated[i] = x[i] * x[i] + y[i] * y[i] + z[i] * z[i] > margin * margin ? 0xFFFFFFFF : 0;
+	}
+}
+
+void CollisionDetectionNarrow::SutherlandHodgman(const ClipPolygon& polygon, const Plane& plane, ClipPolygon& out)
+{
+	out.count = 0;
+
+	// tail vertex of an edge
+	glm::vec3 vertex1 = polygon.vertices[polygon.count - 1];
+	float distance1 = glm::dot(plane.normal, vertex1) - plane.d;
+
+	for (unsigned int i = 0; i < polygon.count; i++)
+	{
+		// head vertex of an edge
+		glm::vec3 vertex2 = polygon.vertices[i];
+		float distance2 = glm::dot(plane.normal, vertex2) - plane.d;
+
+		if (distance1 <= 0.0f && distance2 <= 0.0f)
+		{
+			// both vertices are behind the plane
+			out.vertices[out.count++] = vertex2;
+		}
+		else if (distance1 <= 0.0f && distance2 > 0.0f)
+		{
+			// vertex1 is behind the plane, vertex 2 in front -> intersection
+			float fraction = distance1 / (distance1 - distance2);
+			glm::vec3 intersection = vertex1 + fraction * (vertex2 - vertex1);
+
+			// keep intersection point
+			out.vertices[out.count++] = intersection;
+		}
+		else if (distance2 <= 0.0f && distance1 > 0.0f)
+		{
+			// vertex2 is behind the plane, vertex 1 is in front
+			float fraction = distance1 / (distance1 - distance2);
+			glm::vec3 intersection = vertex1 + fraction * (vertex2 - vertex1);
+
+			// keep intersection point
+			out.vertices[out.count++] = intersection;
+
+			// and also vertex2
+			out.vertices[out.count++] = vertex2;
+		}
+		// keep vertex 2 as tail of the next edge
+		vertex1 = vertex2;
+		distance1 = distance2;
+	}
+}
+
+bool CollisionDetectionNarrow::createFaceCollision(FaceQuery& collisionQuery, ClipPolygon& out)
+{
+	Object* object0 = collisionQuery.object0;
+	Object* object1 = collisionQuery.object1;
+
+	const CompactHull& compact0 = static_cast<Hull*>(object0->model->shape)->compact;
+	const CompactHull& compact1 = static_cast<Hull*>(object1->model->shape)->compact;
+
+	// incident face is clipped in local space of the reference hull
+	glm::mat3 rotationMatrixObject0 = object0->getRotationMatrix();
+	glm::mat3 inverseRotation0 = glm::transpose(rotationMatrixObject0);
+	glm::mat3 rotation = inverseRotation0 * object1->getRotationMatrix();
+	glm::vec3 translation = inverseRotation0 * (object1->getPosition() - object0->getPosition());
+
+	unsigned referenceFace = collisionQuery.faceIndex;
+	unsigned incidentFace = collisionQuery.findIncidentFace();
+
+	const Plane& referencePlane = compact0.facePlanes[referenceFace];
+
+	unsigned firstEdge = compact1.faceEdges[incidentFace];
+	unsigned currentEdge = firstEdge;
+
+	// clipping alternates between 2 buffers
+	ClipPolygon buffer;
+	ClipPolygon* polygon = &out;
+	ClipPolygon* clipped = &buffer;
+	polygon->count = 0;
+
+	// iterate through all incident face edges and build polygon
+	do
+	{
+		polygon->vertices[polygon->count++] = rotation * compact1.getVertex(compact1.edges[currentEdge].origin) + translation;
+		currentEdge = compact1.edges[currentEdge].next;
+	} while (currentEdge != firstEdge);
+
+	firstEdge = compact0.faceEdges[referenceFace];
+	currentEdge = firstEdge;
+
+	// iterate through all reference face edges
+	do
+	{
+		heVertex vertexA = { compact0.getVertex(compact0.edges[currentEdge].origin) };
+
+		// create side plane of an edge
+		glm::vec3 planeNormal = glm::cross(compact0.getEdgeVector(currentEdge), referencePlane.normal);
+		planeNormal = glm::normalize(planeNormal);
+		Plane clippingPlane = { &vertexA, planeNormal };
+
+		// clip plane with polygon (incident face)
+		SutherlandHodgman(*polygon, clippingPlane, *clipped);
+		std::swap(polygon, clipped);
+
+		if (polygon->count < 3)
+			return false;
+
+		currentEdge = compact0.edges[currentEdge].next;
+	} while (currentEdge != firstEdge);
+
+
+	glm::vec3 position0 = object0->getPosition();
+	unsigned count = 0;
+
+	// contact points are written over vertices of clipped polygon, which may be stored in the output buffer
+	for (unsigned i = 0; i < polygon->count; i++)
+	{
+		const glm::vec3& vertex = polygon->vertices[i];
+		float distance;
+		// keep only vertices that are below reference face
+		if ((distance = glm::dot(referencePlane.normal, vertex) - referencePlane.d) < 0.0f)
+		{
+			// move contact point onto referencePlane
+			glm::vec3 contactPoint = vertex + referencePlane.normal * std::abs(distance);
+			out.vertices[count++] = rotationMatrixObject0 * contactPoint + position0;
+		}
+	}
+	out.count = count;
+	return true;
+}
+
+
+CollisionDetectionNarrow::Query::Query()
+{
+	object0 = NULL;
+	object1 = NULL;
+	axis = glm::vec3(0.0f);
+	separationDistance = 0.0f;
+}
+
+unsigned CollisionDetectionNarrow::FaceQuery::findIncidentFace()
+{
+	const CompactHull& compact0 = static_cast<Hull*>(object0->model->shape)->compact;
+	const CompactHull& compact1 = static_cast<Hull*>(object1->model->shape)->compact;
+
+	glm::vec3 referenceFaceNormal = object0->getRotationMatrix() * compact0.facePlanes[faceIndex].normal;
+
+	// reference normal in local space of the second object
+	glm::vec3 localReferenceNormal = glm::transpose(object1->getRotationMatrix()) * referenceFaceNormal;
+
+	unsigned incidentFace = 0;
+	float minimalDot = glm::dot(compact1.facePlanes[0].normal, localReferenceNormal);
+
+	for (unsigned int i = 1; i < compact1.facePlanes.size(); i++)
+	{
+		float dot = glm::dot(compact1.facePlanes[i].normal, localReferenceNormal);
+
+		// incident face is face with smallest dot product with reference face normal
+		if (dot < minimalDot)
+		{
+			minimalDot = dot;
+			incidentFace = i;
+		}
+	}
+
+	return incidentFace;
+}
+
+
+bool CollisionDetectionNarrow::overlap(interval interval0, interval interval1)
+{
+	return !((interval0.max < interval1.min) || (interval1.max < interval0.min));
+}
+
+
+interval CollisionDetectionNarrow::getProjectionInterval(Object* object, const glm::vec3& axis)
+{
+	Shape* shape = object->model->shape;
+
+	if (shape->type == sphere)
+		return static_cast<Sphere*>(shape)->getProjectionInterval(axis, object->getPosition());
+
+	return static_cast<Hull*>(shape)->getProjectionInterval(axis, object->getModelMatrix(), object->supportVertices);
+}
+
+float CollisionDetectionNarrow::getSeparationOnAxis(Object* object0, Object* object1, const glm::vec3& axis)
+{
+	interval interval0 = getProjectionInterval(object0, axis);
+	interval interval1 = getProjectionInterval(object1, axis);
+
+	return std::max(interval1.min - interval0.max, interval0.min - interval1.max);
+}
+
+CollisionDetectionNarrow::FaceQuery CollisionDetectionNarrow::testFaceNormals(Object* object0, Object* object1)
+{
+	FaceQuery query;
+	query.object0 = object0;
+	query.object1 = object1;
+	query.faceIndex = -1;
+	query.separationDistance = FLT_MAX;
+
+	Hull* hull0 = static_cast<Hull*>(object0->model->shape);
+	Hull* hull1 = static_cast<Hull*>(object1->model->shape);
+	const CompactHull& compact0 = hull0->compact;
+	const CompactHull& compact1 = hull1->compact;
+
+	float bestDistance = -FLT_MAX;
+	unsigned int bestFaceIndex = -1;
+
+	// rotation from local space of the first hull to local space of the second one
+	glm::mat3 rotationMatrix0 = object0->getRotationMatrix();
+	glm::mat3 rotation = glm::transpose(object1->getRotationMatrix()) * rotationMatrix0;
+	// position of the second hull in local space of the first one
+	glm::vec3 translation = glm::transpose(rotationMatrix0) * (object1->getPosition() - object0->getPosition());
+
+	for (auto & axis : compact0.faceAxes)
+	{
+		glm::vec3 direction = rotation * axis.normal;
+		float offset = glm::dot(axis.normal, translation);
+
+		const uint16_t faces[2] = { axis.positiveFace, axis.negativeFace };
+
+		for (int side = 0; side < 2; side++)
+		{
+			if (faces[side] == NO_INDEX)
+				continue;
+
+			float sign = side == 0 ? 1.0f : -1.0f;
+
+			// vertex of the second hull deepest below the face
+			unsigned vertex = hull1->findSupportVertex(-sign * direction, object1->supportVertices);
+			float distance = sign * (glm::dot(direction, compact1.getVertex(vertex)) + offset) - compact0.facePlanes[faces[side]].d;
+
+			if (distance > 0.0f)
+			{
+				query.separationDistance = FLT_MAX;
+				return query;
+			}
+
+			if (distance > bestDistance)
+			{
+				bestDistance = distance;
+				bestFaceIndex = faces[side];
+			}
+		}
+	}
+
+	query.faceIndex = bestFaceIndex;
+	query.separationDistance = bestDistance;
+
+	return query;
+}
+
+CollisionDetectionNarrow::EdgeQuery CollisionDetectionNarrow::testEdgeDirections(Object* object0, Object* object1)
+{
+	EdgeQuery query;
+	query.object0 = object0;
+	query.object1 = object1;
+	query.separationDistance = -FLT_MAX;
+
+	Hull* hull0 = static_cast<Hull*>(object0->model->shape);
+	Hull* hull1 = static_cast<Hull*>(object1->model->shape);
+
+	const CompactHull& compact0 = hull0->compact;
+	const CompactHull& compact1 = hull1->compact;
+
+	// edges without twin have no arc on Gauss map
+	if (!compact0.closed || !compact1.closed)
+		return query;
+
+	// edges are compared in local space of the first hull
+	glm::mat3 rotationMatrix0 = object0->getRotationMatrix();
+	glm::mat3 inverseRotation0 = glm::transpose(rotationMatrix0);
+	glm::mat3 rotation = inverseRotation0 * object1->getRotationMatrix();
+	glm::vec3 translation = inverseRotation0 * (object1->getPosition() - object0->getPosition());
+	// hull is not centred at the origin of its local space, model centre lies inside the hull
+	glm::vec3 center0 = object0->model->localCenter;
+
+	// edges of the second hull are transformed in blocks held on stack, every block is tested against all edges of the first hull
+	constexpr unsigned blockSize = 64;
+	glm::vec3 tails1[blockSize];
+	glm::vec3 directions1[blockSize];
+	glm::vec3 normalsC[blockSize];
+	glm::vec3 normalsD[blockSize];
+
+	unsigned edgeCount1 = compact1.uniqueEdges.size();
+
+	for (unsigned blockStart = 0; blockStart < edgeCount1; blockStart += blockSize)
+	{
+		unsigned blockCount = std::min(blockSize, edgeCount1 - blockStart);
+
+		for (unsigned j = 0; j < blockCount; j++)
+		{
+			const CompactHalfEdge& edge1 = compact1.edges[compact1.uniqueEdges[blockStart + j]];
+			tails1[j] = rotation * compact1.getVertex(edge1.origin) + translation;
+			directions1[j] = rotation * compact1.uniqueEdgeDirections[blockStart + j];
+			normalsC[j] = rotation * compact1.facePlanes[edge1.face].normal;
+			normalsD[j] = rotation * compact1.facePlanes[compact1.edges[edge1.twin].face].normal;
+		}
+
+		for (unsigned i = 0; i < compact0.uniqueEdges.size(); i++)
+		{
+			const CompactHalfEdge& edge0 = compact0.edges[compact0.uniqueEdges[i]];
+			glm::vec3 tail0 = compact0.getVertex(edge0.origin);
+			const glm::vec3& direction0 = compact0.uniqueEdgeDirections[i];
+			const glm::vec3& a = compact0.facePlanes[edge0.face].normal;
+			const glm::vec3& b = compact0.facePlanes[compact0.edges[edge0.twin].face].normal;
+
+			for (unsigned j = 0; j < blockCount; j++)
+			{
+				// Minkowski difference uses negated second hull
+				if (!isMinkowskiFace(a, b, -normalsC[j], -normalsD[j]))
+					continue;
+
+				glm::vec3 axis = glm::cross(direction0, directions1[j]);
+
+				// parallel edges, axis is covered by face normals
+				if (isZeroVector(axis))
+					continue;
+
+				axis = glm::normalize(axis);
+
+				// axis has to point out of the first hull, away from its centre
+				if (glm::dot(axis, tail0 - center0) < 0.0f)
+					axis = -axis;
+
+				float distance = glm::dot(axis, tails1[j] - tail0);
+
+				if (distance > query.separationDistance)
+				{
+					query.separationDistance = distance;
+					query.axis = rotationMatrix0 * axis;
+					query.edge0 = compact0.uniqueEdges[i];
+					query.edge1 = compact1.uniqueEdges[blockStart + j];
+
+					if (distance > 0.0f)
+					{
+						// separating axis found
+						return query;
+					}
+				}
+			}
+		}
+	}
+
+	return query;
+}
+
+bool CollisionDetectionNarrow::isMinkowskiFace(const glm::vec3& a, const glm::vec3& b, const glm::vec3& c, const glm::vec3& d)
+{
+	glm::vec3 bxa = glm::cross(b, a);
+	glm::vec3 dxc = glm::cross(d, c);
+
+	float cba = glm::dot(c, bxa);
+	float dba = glm::dot(d, bxa);
+	float adc = glm::dot(a, dxc);
+	float bdc = glm::dot(b, dxc);
+
+	// arcs intersect if each arc's great circle separates the other arc's ends and arcs lie on the same hemisphere
+	return cba * dba < 0.0f && adc * bdc < 0.0f && cba * bdc > 0.0f;
+}
+
+glm::vec3 CollisionDetectionNarrow::createEdgeCollision(const EdgeQuery& collisionQuery)
+{
+	glm::mat4 transformationMatrixObject0 = collisionQuery.object0->getModelMatrix();
+	glm::mat4 transformationMatrixObject1 = collisionQuery.object1->getModelMatrix();
+	const CompactHull& compact0 = static_cast<Hull*>(collisionQuery.object0->model->shape)->compact;
+	const CompactHull& compact1 = static_cast<Hull*>(collisionQuery.object1->model->shape)->compact;
+
+	glm::vec3 p0 = transformationMatrixObject0 * glm::vec4(compact0.getVertex(compact0.edges[collisionQuery.edge0].origin), 1.0f);
+	glm::vec3 q0 = transformationMatrixObject0 * glm::vec4(compact0.getVertex(compact0.getHead(collisionQuery.edge0)), 1.0f);
+	glm::vec3 p1 = transformationMatrixObject1 * glm::vec4(compact1.getVertex(compact1.edges[collisionQuery.edge1].origin), 1.0f);
+	glm::vec3 q1 = transformationMatrixObject1 * glm::vec4(compact1.getVertex(compact1.getHead(collisionQuery.edge1)), 1.0f);
+
+	return getSegmentsMidpoint(p0, q0, p1, q1);
+}
+
+glm::vec3 CollisionDetectionNarrow::getSegmentsMidpoint(const glm::vec3& p0, const glm::vec3& q0, const glm::vec3& p1, const glm::vec3& q1)
+{
+	// closest points of 2 segments
+	glm::vec3 d0 = q0 - p0;
+	glm::vec3 d1 = q1 - p1;
+	glm::vec3 r = p0 - p1;
+
+	float a = glm::dot(d0, d0);
+	float e = glm::dot(d1, d1);
+	float b = glm::dot(d0, d1);
+	float c = glm::dot(d0, r);
+	float f = glm::dot(d1, r);
+	float denominator = a * e - b * b;
+
+	float s = 0.0f;
+	if (denominator > EPSILON)
+	{
+		s = glm::clamp((b * f - c * e) / denominator, 0.0f, 1.0f);
+	}
+	float t = glm::clamp((b * s + f) / e, 0.0f, 1.0f);
+	s = glm::clamp((b * t - c) / a, 0.0f, 1.0f);
+
+	glm::vec3 closest0 = p0 + d0 * s;
+	glm::vec3 closest1 = p1 + d1 * t;
+
+	return 0.5f * (closest0 + closest1);
+}
+
+CollisionDetectionNarrow::EdgeQuery::EdgeQuery()
+{
+	edge0 = NO_INDEX;
+	edge1 = NO_INDEX;
+}
+
+CollisionDetectionNarrow::WorldBox::WorldBox(Object* object)
+{
+	const OrientedBox& box = static_cast<Hull*>(object->model->shape)->orientedBox;
+	glm::mat3 rotationMatrix = object->getRotationMatrix();
+
+	axes = rotationMatrix * box.axes;
+	center = rotationMatrix * box.center + object->getPosition();
+	halfExtents = box.halfExtents;
+}
+
+bool isZeroVector(glm::vec3 vector)
+{
+	return std::abs(glm::length(vector)) < EPSILON;
+}
@@ -1,152 +1,515 @@
-/**
- * Bakalarska praca - Simualace pevnych teles
- * VUT FIT, 2018/2019
- *
- * Autor:	Denis Leitner, xleitn02
- * Subor:	CollisionDetectionNarrow.h
- *
- */
-
-#pragma once
-
-#ifndef COLLISION_DETECTION_NARROW_H
-#define COLLISION_DETECTION_NARROW_H
-
-#define GLM_ENABLE_EXPERIMENTAL
-#include <glm/glm.hpp>
-#include <glm/gtx/string_cast.hpp>
-#include <vector>
-
-#include "Hull.h"
-#include "Object.h"
-#include "PlaneShape.h"
-
-constexpr float COEFFICIENT_OF_RESTITUTION = 0.5f;
-
-struct CollisionData
-{
-	Object* object0;
-	Object* object1;
-	glm::vec3 collisionNormal;		// collision normal must point from object1 to object0
-	glm::vec3 collisionPoint;
-};
-
-class CollisionDetectionNarrow
-{
-public:
-	CollisionDetectionNarrow();
-
-	/**
-	 * @brief Decides which collision routine to choose according to shape of an object
-	 * @return Whether objects collide
-	 */
-	bool checkCollision(CollisionData& collision, Object* object0, Object* object1);
-
-private:
-
-	struct Query
-	{
-		Object *object0;
-		Object* object1;
-		glm::vec3 axis;				// collision axis in world-space
-		float separationDistance;
-		Query();
-	};
-
-	struct FaceQuery : Query
-	{
-		unsigned int faceIndex;
-
-		/**
-		 * @brief Finds incident face of second colliding object
-		 */
-		heFace* findIncidentFace();
-	};
-
-	/**
-	 * @brief Checks whether given objects collide, both objects are represented by convex hull
-	 * @param[out] collision Informations about collision
-	 * @param object0	First object to check for collision
-	 * @param object1	Second object to check for collision
-	 * @return			Whether objects collide or not
-	 */
-	bool checkCollisionHulls(CollisionData& collision, Object* object0, Object* object1);
-
-	/**
-	 * @brief Checks whether sphere objects collide
-	 * @param[out] collision Informations about collision
-	 * @param object0	First object to check for collision
-	 * @param object1	Second object to check for collision
-	 * @return			Whether objects collide or not
-	 */
-	bool checkCollisionSpheres(CollisionData& collision, Object* object0, Object* object1);
-
-	/**
-	 * @brief Checks whether plane and sphere collide
-	 * @param[out] collision Informations about collision
-	 * @param planeObject Plane object to check for collision
-	 * @param sphereObject Sphere object to check for collision
-	 * @return			Whether objects collide or not
-	 */
-	bool checkCollisionPlaneSphere(CollisionData& collision, Object* planeObject, Object* sphereObject);
-
-	/**
-	 * @brief Checks whether given objects collide, first object is hull, second is sphere
-	 * @param[out] collision Informations about collision
-	 * @param hullObject Hull object to check for collision
-	 * @param sphereObject Sphere object to check for collision
-	 * @return			Whether objects collide or not
-	 */
-	bool checkCollisionHullSphere(CollisionData& collision, Object* hullObject, Object* sphereObject);
-
-	/**
-	 * @brief Pushes objects out of collision, uses MTV
-	 * @param object0 First object to push out of collision
-	 * @param object1 Second object to push out of collision
-	 * @param collisionNormal Collision normal pointing from object1 to object0
-	 * @param seperationDistance Distance that separates both objects
-	 */
-	void pushObjectsOutOfCollision(Object* object0, Object* object1, const glm::vec3& collisionNormal, float seperationDistance);
-
-	/**
-	 * @brief Checks for overlap between 2 objects, as potential separating axes uses face normals
-	 * @param object0 First object to be checked
-	 * @param object1 Second object to be checked
-	 * @return Information about collision 
-	 */
-	FaceQuery testFaceNormals(Object* object0, Object* object1);
-
-	/**
-	 * @brief Checks whether 2 intervals overlap
-	 * @param interval0	First interval to check
-	 * @param interval1	Second interval to check
-	 * @return			Whether 2 intervals overlap or no
-	 */
-	bool overlap(interval interval0, interval interval1);
-
-	/**
-	 * @brief Performs Sutherland-Hodgman clipping of polygon against plane
-	 * @param polygon	Polygon that we want to clip, represented as it's vertices
-	 * @param plane		Plane against which to clip
-	 * @param[out] out	Clipped polygon
-	 */
-	void SutherlandHodgman(const std::vector<heVertex>& polygon, const Plane& plane, std::vector<heVertex>& out);
-
-	/**
-	 * @brief Finds all collision points of given face-face collision query
-	 * @param collisionQuery	Face-face collision query for which to find collision points
-	 * @param[out] out			Found collision points
-	 * @return					Whether collision could be created
-	 */
-	bool createFaceCollision(FaceQuery& collisionQuery, std::vector<glm::vec3>& out);
-};
-
-/**
- * @brief Checks if given vector is near zero vector(because of floating point arithmetics)
- * @param	Vector to be checked
- * @return	Whether vector is near zero length or not
- */
-bool isZeroVector(glm::vec3 vector);
-
-#endif
-
+/**
+ * Bakalarska praca - Simualace pevnych teles
+ * VUT FIT, 2018/2019
+ *
+ * Autor:	Denis Leitner, xleitn02
+ * Subor:	CollisionDetectionNarrow.h
+ *
+ */
+
+#pragma once
+
+#ifndef COLLISION_DETECTION_NARROW_H
+#define COLLISION_DETECTION_NARROW_H
+
+#define GLM_ENABLE_EXPERIMENTAL
+#include <glm/glm.hpp>
+#include <glm/gtx/string_cast.hpp>
+#include <map>
+#include <utility>
+#include <vector>
+
+#include "BroadPhase.h"
+#include "Compound.h"
+#include "GJK.h"
+#include "HalfSpace.h"
+#include "Hull.h"
+#include "Object.h"
+#include "PlaneShape.h"
+#include "TriangleMesh.h"
+
+constexpr float COEFFICIENT_OF_RESTITUTION = 0.5f;
+// distance at which conservative advancement considers objects touching
+constexpr float TIME_OF_IMPACT_TOLERANCE = 0.005f;
+constexpr unsigned TIME_OF_IMPACT_MAX_ITERATIONS = 32;
+// distance of motion after which object touching at its beginning is checked whether it moves into the other object
+constexpr float TIME_OF_IMPACT_PROBE_DISTANCE = 4.0f * TIME_OF_IMPACT_TOLERANCE;
+// upper limit of edge pairs of 2 hulls whose cross products are used as separating axes
+constexpr unsigned SEPARATION_MAX_EDGE_AXES = 256;
+// estimated number of SAT projections of 2 hulls from which GJK is chosen automatically
+constexpr unsigned GJK_MIN_SAT_COST = 512;
+// tolerances of choosing between face and edge contacts
+constexpr float LINEAR_SLOP = 0.005f;
+constexpr float RELATIVE_EDGE_TOLERANCE = 0.90f;
+constexpr float RELATIVE_FACE_TOLERANCE = 0.98f;
+constexpr float ABSOLUTE_TOLERANCE = 0.5f * LINEAR_SLOP;
+// capacity of clipping buffers, every clipping plane adds at most one vertex to incident face
+constexpr unsigned MAX_CLIP_VERTICES = 2 * MAX_FACE_VERTICES;
+// upper limit of hull vertices below a plane averaged into contact point
+constexpr unsigned MAX_CONTACT_VERTICES = 64;
+// number of pairs of spheres tested together by batched narrow phase
+constexpr unsigned BATCH_SIZE = 8;
+// relative margin of batched tests, pairs that nearly touch are left to exact routines
+constexpr float BATCH_MARGIN = 0.001f;
+// groups of pairs, one for each unordered pair of shape types, the smaller type first
+constexpr unsigned PAIR_GROUP_COUNT = SHAPE_TYPE_COUNT * SHAPE_TYPE_COUNT;
+constexpr unsigned SPHERE_GROUP = sphere * SHAPE_TYPE_COUNT + sphere;
+
+/**
+ * @brief Algorithm used for collision of 2 hulls
+ */
+enum HullAlgorithm { automaticAlgorithm, separatingAxes, gjkEpa };
+
+struct CollisionData
+{
+	Object* object0;
+	Object* object1;
+	glm::vec3 collisionNormal;		// collision normal must point from object1 to object0
+	glm::vec3 collisionPoint;
+	float depth;					// penetration along the normal, removed by position solver of simulation
+};
+
+class CollisionDetectionNarrow
+{
+public:
+	// collision routine for objects of 2 shape types
+	typedef bool (CollisionDetectionNarrow::*CollisionFunction)(CollisionData& collision, Object* object0, Object* object1);
+
+	CollisionDetectionNarrow();
+
+	/**
+	 * @brief Calls collision routine registered for shape types of objects
+	 * @return Whether objects collide
+	 */
+	bool checkCollision(CollisionData& collision, Object* object0, Object* object1);
+
+	/**
+	 * @brief Checks collisions of all pairs, pairs are grouped by shape types and each group is processed at once,
+	 *        separated pairs of spheres are rejected BATCH_SIZE at a time
+	 * @param pairs Pairs of objects found by broad phase
+	 * @param[out] collisions Collisions are appended in order in which they were found
+	 */
+	void checkCollisions(const std::vector<ObjectPair>& pairs, std::vector<CollisionData>& collisions);
+
+	/**
+	 * @brief Registers collision routine for pair of shape types, the routine is used also for the swapped pair
+	 *        with objects passed in reversed order, unless other routine was registered for it
+	 * @param type0 Shape type of the first object passed to the routine
+	 * @param type1 Shape type of the second object passed to the routine
+	 * @param function Collision routine
+	 */
+	void registerCollisionFunction(ShapeType type0, ShapeType type1, CollisionFunction function);
+
+	/**
+	 * @brief Computes lower bound of distance between objects as the largest gap between their projections
+	 *        onto candidate separating axes (face normals, direction between centres, edge cross products of small hulls)
+	 * @return Lower bound of distance, not positive if no separating axis was found
+	 */
+	float getSeparation(Object* object0, Object* object1);
+
+	/**
+	 * @brief Finds first time at which moving object touches other object by conservative advancement,
+	 *        object is moved only by translation, its rotation and the other object are kept fixed;
+	 *        if advancement doesn't converge, the last conservative time is returned as impact
+	 * @param object Moving object, positioned at the end of its motion
+	 * @param other Other object
+	 * @param motion Translation of moving object during the step
+	 * @param[out] time Fraction of the motion at which objects touch, in range [0, 1]
+	 * @return Whether objects touch during the motion; objects touching already at its beginning are left
+	 *         to discrete collision at the end of the motion, unless the object moves into the other one,
+	 *         then impact at time 0 keeps it at the beginning, where discrete collision finds the contact
+	 */
+	bool findTimeOfImpact(Object* object, Object* other, const glm::vec3& motion, float& time);
+
+	/**
+	 * @brief Chooses algorithm for collisions of hulls of given shapes, order of shapes doesn't matter
+	 * @param shape0 First shape
+	 * @param shape1 Second shape
+	 * @param algorithm Algorithm to use, automaticAlgorithm chooses GJK for hulls with many faces
+	 */
+	void setHullAlgorithm(Shape* shape0, Shape* shape1, HullAlgorithm algorithm);
+
+	/**
+	 * @brief Computes closest points of 2 separated hulls by GJK, e.g. for speculative contacts
+	 * @param object0 First object, must be hull
+	 * @param object1 Second object, must be hull
+	 * @param[out] point0 Closest point of the first object
+	 * @param[out] point1 Closest point of the second object
+	 * @param[out] distance Distance of objects
+	 * @return Whether objects are separated, outputs are valid only if they are
+	 */
+	bool getClosestPoints(Object* object0, Object* object1, glm::vec3& point0, glm::vec3& point1, float& distance);
+
+	/**
+	 * @brief Computes boundary plane of half-space in world space
+	 * @param halfSpaceObject Half-space object
+	 * @param[out] normal Outer normal of the plane
+	 * @return Dot product of normal and any point of the plane
+	 */
+	float getHalfSpacePlane(Object* halfSpaceObject, glm::vec3& normal);
+
+private:
+
+	/**
+	 * @brief Entry of collision dispatch table
+	 */
+	struct CollisionDispatch
+	{
+		CollisionFunction function;		// NULL if objects of the shape types don't collide
+		bool swapObjects;				// whether objects are passed to the routine in reversed order
+	};
+
+	// collision routines indexed by shape types of the first and the second object
+	CollisionDispatch collisionFunctions[SHAPE_TYPE_COUNT][SHAPE_TYPE_COUNT];
+
+	// pairs of the current step sorted into groups, kept between steps to avoid allocation
+	std::vector<ObjectPair> pairGroups[PAIR_GROUP_COUNT];
+
+	// triangles of mesh found by the last query, kept between queries to avoid allocation
+	std::vector<unsigned> meshTriangles;
+
+	// algorithms chosen for pairs of shapes, pair is ordered by address
+	std::map<std::pair<Shape*, Shape*>, HullAlgorithm> hullAlgorithms;
+
+	struct Query
+	{
+		Object *object0;
+		Object* object1;
+		glm::vec3 axis;				// collision axis in world-space
+		float separationDistance;
+		Query();
+	};
+
+	struct FaceQuery : Query
+	{
+		unsigned int faceIndex;
+
+		/**
+		 * @brief Finds incident face of second colliding object
+		 * @return Index of the face in compact hull of the second object
+		 */
+		unsigned findIncidentFace();
+	};
+
+	struct EdgeQuery : Query
+	{
+		unsigned edge0;		// edge of the first object, index into its compact hull
+		unsigned edge1;		// edge of the second object, index into its compact hull
+		EdgeQuery();
+	};
+
+	/**
+	 * @brief Polygon of fixed capacity used for clipping, so that no memory is allocated during collision
+	 */
+	struct ClipPolygon
+	{
+		glm::vec3 vertices[MAX_CLIP_VERTICES];
+		unsigned count;
+	};
+
+	/**
+	 * @brief Box of an object in world space
+	 */
+	struct WorldBox
+	{
+		glm::mat3 axes;			// axes of the box as columns
+		glm::vec3 center;
+		glm::vec3 halfExtents;
+
+		WorldBox(Object* object);
+	};
+
+	/**
+	 * @brief Checks whether given objects collide, both objects are represented by convex hull
+	 * @param[out] collision Informations about collision
+	 * @param object0	First object to check for collision
+	 * @param object1	Second object to check for collision
+	 * @return			Whether objects collide or not
+	 */
+	bool checkCollisionHulls(CollisionData& collision, Object* object0, Object* object1);
+
+	/**
+	 * @brief Checks whether given objects collide, both objects are represented by convex hull,
+	 *        SAT or GJK is used according to selectHullAlgorithm
+	 * @param[out] collision Informations about collision
+	 * @param object0	First object to check for collision
+	 * @param object1	Second object to check for collision
+	 * @return			Whether objects collide or not
+	 */
+	bool checkCollisionConvexHulls(CollisionData& collision, Object* object0, Object* object1);
+
+	/**
+	 * @brief Checks whether given objects collide by GJK, penetration is computed by EPA,
+	 *        both objects are represented by convex hull
+	 * @param[out] collision Informations about collision
+	 * @param object0	First object to check for collision
+	 * @param object1	Second object to check for collision
+	 * @return			Whether objects collide or not
+	 */
+	bool checkCollisionHullsGJK(CollisionData& collision, Object* object0, Object* object1);
+
+	/**
+	 * @brief Chooses algorithm for collision of 2 hulls, unless it was set for their shapes,
+	 *        GJK is used when SAT would need many projections
+	 * @return Algorithm to use, never automaticAlgorithm
+	 */
+	HullAlgorithm selectHullAlgorithm(Object* object0, Object* object1);
+
+	/**
+	 * @brief Checks whether given boxes collide by SAT with 15 axes of oriented boxes, contact is found by clipping box faces
+	 * @param[out] collision Informations about collision
+	 * @param object0	First object to check for collision, its hull must be box
+	 * @param object1	Second object to check for collision, its hull must be box
+	 * @return			Whether objects collide or not
+	 */
+	bool checkCollisionBoxes(CollisionData& collision, Object* object0, Object* object1);
+
+	/**
+	 * @brief Checks whether box and sphere collide using point of the box closest to sphere centre
+	 * @param[out] collision Informations about collision
+	 * @param boxObject Object whose hull is box
+	 * @param sphereObject Sphere object to check for collision
+	 * @return			Whether objects collide or not
+	 */
+	bool checkCollisionBoxSphere(CollisionData& collision, Object* boxObject, Object* sphereObject);
+
+	/**
+	 * @brief Checks whether half-space and sphere collide
+	 * @param[out] collision Informations about collision
+	 * @param halfSpaceObject Half-space object to check for collision
+	 * @param sphereObject Sphere object to check for collision
+	 * @return			Whether objects collide or not
+	 */
+	bool checkCollisionHalfSpaceSphere(CollisionData& collision, Object* halfSpaceObject, Object* sphereObject);
+
+	/**
+	 * @brief Checks whether half-space and hull collide, penetration is found by one support query,
+	 *        contact is average of hull vertices below boundary plane found by walking from the deepest one
+	 * @param[out] collision Informations about collision
+	 * @param halfSpaceObject Half-space object to check for collision
+	 * @param hullObject Hull object to check for collision
+	 * @return			Whether objects collide or not
+	 */
+	bool checkCollisionHalfSpaceHull(CollisionData& collision, Object* halfSpaceObject, Object* hullObject);
+
+	/**
+	 * @brief Checks whether compound and other object collide, children whose bounds overlap AABB of the other object
+	 *        are tested by routines of their shapes; contacts of children are merged into one with average point and normal
+	 * @param[out] collision Informations about collision
+	 * @param compoundObject Compound object to check for collision
+	 * @param other Object of any shape, also compound
+	 * @return			Whether objects collide or not
+	 */
+	bool checkCollisionCompound(CollisionData& collision, Object* compoundObject, Object* other);
+
+	/**
+	 * @brief Checks whether triangle mesh and sphere collide, only triangles near the sphere are tested,
+	 *        contacts with triangles are merged into one with average point and normal
+	 * @param[out] collision Informations about collision
+	 * @param meshObject Mesh object to check for collision
+	 * @param sphereObject Sphere object to check for collision
+	 * @return			Whether objects collide or not
+	 */
+	bool checkCollisionMeshSphere(CollisionData& collision, Object* meshObject, Object* sphereObject);
+
+	/**
+	 * @brief Checks whether triangle mesh and hull collide, only triangles near the hull are tested,
+	 *        contacts with triangles are merged into one with average point and normal
+	 * @param[out] collision Informations about collision
+	 * @param meshObject Mesh object to check for collision
+	 * @param hullObject Hull object to check for collision
+	 * @return			Whether objects collide or not
+	 */
+	bool checkCollisionMeshHull(CollisionData& collision, Object* meshObject, Object* hullObject);
+
+	/**
+	 * @brief Checks whether hull and one-sided triangle collide by SAT, axes are normal of the triangle,
+	 *        face normals of the hull and cross products of their edges, unless the hull has many edges
+	 * @param hull Hull to check for collision
+	 * @param transform Transformation of the hull into local space of the mesh
+	 * @param supportCache Support vertices of the hull object
+	 * @param triangle Triangle in local space of the mesh
+	 * @param[out] normal Contact normal pointing from the triangle to the hull
+	 * @param[out] depth Penetration depth along the normal
+	 * @param[out] point Contact point in local space of the mesh
+	 * @return Whether hull and triangle collide
+	 */
+	bool findTriangleContact(Hull* hull, const glm::mat4& transform, uint16_t* supportCache, const MeshTriangle& triangle,
+		glm::vec3& normal, float& depth, glm::vec3& point);
+
+	/**
+	 * @brief Computes lower bound of distance of object and one-sided triangle, exact for spheres
+	 * @param object Sphere or hull object
+	 * @param transform Transformation of the object into local space of the mesh
+	 * @param triangle Triangle in local space of the mesh
+	 * @return Lower bound of distance, not positive if objects may intersect
+	 */
+	float getTriangleSeparation(Object* object, const glm::mat4& transform, const MeshTriangle& triangle);
+
+	/**
+	 * @brief Finds bounds and transformation of object in local space of other object
+	 * @param object Object whose local space is used
+	 * @param other Object whose AABB is transformed
+	 * @param[out] min Minimal corner of box covering AABB of the other object
+	 * @param[out] max Maximal corner of box covering AABB of the other object
+	 * @return Transformation of the other object into local space of the object
+	 */
+	glm::mat4 getLocalBounds(Object* object, Object* other, glm::vec3& min, glm::vec3& max);
+
+	/**
+	 * @brief Finds vertices of hull below plane, for closed hull they are found by walking from the deepest one
+	 * @param compact Hull whose vertices are searched
+	 * @param normal Normal of the plane in local space of the hull
+	 * @param offset Dot product of normal and any point of the plane
+	 * @param deepestVertex Vertex of the hull deepest below the plane
+	 * @param[out] found Indices of found vertices, array of MAX_CONTACT_VERTICES elements
+	 * @return Number of found vertices
+	 */
+	unsigned findVerticesBelowPlane(const CompactHull& compact, const glm::vec3& normal, float offset, unsigned deepestVertex, uint16_t* found);
+
+	/**
+	 * @brief Finds contact of 2 boxes by clipping the incident face against side planes of reference face
+	 * @param reference Box with reference face
+	 * @param axis Index of axis of the reference box perpendicular to reference face
+	 * @param normal Normal of reference face, points toward incident box
+	 * @param incident Box with incident face
+	 * @param[out] contact Average of contact points
+	 * @return Whether any contact point was found
+	 */
+	bool createBoxFaceCollision(const WorldBox& reference, int axis, const glm::vec3& normal, const WorldBox& incident, glm::vec3& contact);
+
+	/**
+	 * @brief Checks whether sphere objects collide
+	 * @param[out] collision Informations about collision
+	 * @param object0	First object to check for collision
+	 * @param object1	Second object to check for collision
+	 * @return			Whether objects collide or not
+	 */
+	bool checkCollisionSpheres(CollisionData& collision, Object* object0, Object* object1);
+
+	/**
+	 * @brief Checks whether plane and sphere collide
+	 * @param[out] collision Informations about collision
+	 * @param planeObject Plane object to check for collision
+	 * @param sphereObject Sphere object to check for collision
+	 * @return			Whether objects collide or not
+	 */
+	bool checkCollisionPlaneSphere(CollisionData& collision, Object* planeObject, Object* sphereObject);
+
+	/**
+	 * @brief Checks whether given objects collide, first object is hull, second is sphere
+	 * @param[out] collision Informations about collision
+	 * @param hullObject Hull object to check for collision
+	 * @param sphereObject Sphere object to check for collision
+	 * @return			Whether objects collide or not
+	 */
+	bool checkCollisionHullSphere(CollisionData& collision, Object* hullObject, Object* sphereObject);
+
+	/**
+	 * @brief Finds point of hull face closest to given point, both points are in local space of the hull
+	 * @param compact Hull whose face is searched
+	 * @param face Index of the face
+	 * @param point Point for which to find closest point
+	 * @param[out] closest Closest point of the face
+	 * @return Whether the closest point is inside the face, i.e. point lies in Voronoi region of the face
+	 */
+	bool findClosestPointOnFace(const CompactHull& compact, unsigned face, const glm::vec3& point, glm::vec3& closest);
+
+	/**
+	 * @brief Tests batch of pairs of spheres for separation
+	 * @param pairs Pairs of spheres
+	 * @param count Number of pairs, at most BATCH_SIZE
+	 * @param[out] separated Mask of all ones if spheres of the pair are separated, zero otherwise, for each pair
+	 */
+	void findSeparatedSpheres(const ObjectPair* pairs, unsigned count, uint32_t* separated);
+
+	/**
+	 * @brief Checks for overlap between 2 objects, as potential separating axes uses face normals
+	 * @param object0 First object to be checked
+	 * @param object1 Second object to be checked
+	 * @return Information about collision 
+	 */
+	FaceQuery testFaceNormals(Object* object0, Object* object1);
+
+	/**
+	 * @brief Checks for overlap between 2 objects, as potential separating axes uses cross products of edges;
+	 *        only edge pairs whose arcs on Gauss map intersect, i.e. that form face of Minkowski difference, are tested
+	 * @param object0 First object to be checked
+	 * @param object1 Second object to be checked
+	 * @return Information about collision, separation distance is -FLT_MAX if no edge pair was tested
+	 */
+	EdgeQuery testEdgeDirections(Object* object0, Object* object1);
+
+	/**
+	 * @brief Checks whether arcs of 2 edges on Gauss map intersect; arc of an edge connects normals of its 2 faces
+	 * @param a Normal of the first face of the first edge
+	 * @param b Normal of the second face of the first edge
+	 * @param c Negated normal of the first face of the second edge
+	 * @param d Negated normal of the second face of the second edge
+	 * @return Whether edges form face of Minkowski difference
+	 */
+	bool isMinkowskiFace(const glm::vec3& a, const glm::vec3& b, const glm::vec3& c, const glm::vec3& d);
+
+	/**
+	 * @brief Creates contact of edge-edge collision as midpoint of closest points of both edges
+	 * @param collisionQuery Edge-edge collision query
+	 * @return Contact point in world space
+	 */
+	glm::vec3 createEdgeCollision(const EdgeQuery& collisionQuery);
+
+	/**
+	 * @brief Finds midpoint of closest points of 2 segments
+	 * @param p0, q0 End points of the first segment
+	 * @param p1, q1 End points of the second segment
+	 * @return Midpoint of closest points
+	 */
+	glm::vec3 getSegmentsMidpoint(const glm::vec3& p0, const glm::vec3& q0, const glm::vec3& p1, const glm::vec3& q1);
+
+	/**
+	 * @brief Checks whether 2 intervals overlap
+	 * @param interval0	First interval to check
+	 * @param interval1	Second interval to check
+	 * @return			Whether 2 intervals overlap or no
+	 */
+	bool overlap(interval interval0, interval interval1);
+
+	/**
+	 * @brief Projects object onto axis
+	 * @param object Object to project
+	 * @param axis Axis onto which to project
+	 * @return Projection interval
+	 */
+	interval getProjectionInterval(Object* object, const glm::vec3& axis);
+
+	/**
+	 * @brief Gap between projections of 2 objects onto axis
+	 * @return Size of the gap, negative if projections overlap
+	 */
+	float getSeparationOnAxis(Object* object0, Object* object1, const glm::vec3& axis);
+
+	/**
+	 * @brief Performs Sutherland-Hodgman clipping of polygon against plane
+	 * @param polygon	Polygon that we want to clip, represented as it's vertices
+	 * @param plane		Plane against which to clip
+	 * @param[out] out	Clipped polygon
+	 */
+	void SutherlandHodgman(const ClipPolygon& polygon, const Plane& plane, ClipPolygon& out);
+
+	/**
+	 * @brief Finds all collision points of given face-face collision query
+	 * @param collisionQuery	Face-face collision query for which to find collision points
+	 * @param[out] out			Found collision points
+	 * @return					Whether collision could be created
+	 */
+	bool createFaceCollision(FaceQuery& collisionQuery, ClipPolygon& out);
+};
+
+/**
+ * @brief Checks if given vector is near zero vector(because of floating point arithmetics)
+ * @param	Vector to be checked
+ * @return	Whether vector is near zero length or not
+ */
+bool isZeroVector(glm::vec3 vector);
+
+#endif
+
@@ -0,0 +1,172 @@
+/**
+ * Bakalarska praca - Simualace pevnych teles
+ * VUT FIT, 2018/2019
+ *
+ * Autor:	Denis Leitner, xleitn02
+ * Subor:	CompactHull.cpp
+ *
+ */
+
+#include "CompactHull.h"
+#include <cfloat>
+#include <unordered_map>
+
+
+CompactHull::CompactHull()
+{
+	closed = false;
+}
+
+bool CompactHull::build(const std::vector<heVertex*>& vertices, const std::vector<heFace*>& faces)
+{
+	std::unordered_map<const heVertex*, uint16_t> vertexIndices;
+	std::unordered_map<const HalfEdge*, uint16_t> edgeIndices;
+
+	if (vertices.size() >= NO_INDEX || faces.size() >= NO_INDEX)
+		return false;
+
+	for (unsigned i = 0; i < vertices.size(); i++)
+	{
+		vertexIndices[vertices[i]] = i;
+		vertexX.push_back(vertices[i]->position.x);
+		vertexY.push_back(vertices[i]->position.y);
+		vertexZ.push_back(vertices[i]->position.z);
+	}
+
+	// edges are numbered face by face, so that edges of one face are next to each other
+	for (auto & face : faces)
+	{
+		HalfEdge* edge = face->edge;
+		unsigned faceVertices = 0;
+		do
+		{
+			if (edgeIndices.size() >= NO_INDEX || ++faceVertices > MAX_FACE_VERTICES)
+				return false;
+
+			uint16_t index = edgeIndices.size();
+			edgeIndices[edge] = index;
+			edge = edge->next;
+		} while (edge != face->edge);
+	}
+
+	edges.resize(edgeIndices.size());
+	vertexEdges.assign(vertices.size(), NO_INDEX);
+	closed = !edges.empty();
+
+	for (unsigned i = 0; i < faces.size(); i++)
+	{
+		HalfEdge* edge = faces[i]->edge;
+		faceEdges.push_back(edgeIndices[edge]);
+		facePlanes.push_back(Plane(edge->tail, faces[i]->normal));
+
+		do
+		{
+			uint16_t index = edgeIndices[edge];
+			CompactHalfEdge& compactEdge = edges[index];
+
+			compactEdge.origin = vertexIndices[edge->tail];
+			compactEdge.next = edgeIndices[edge->next];
+			compactEdge.face = i;
+			compactEdge.twin = edge->twin != NULL ? edgeIndices[edge->twin] : NO_INDEX;
+
+			vertexEdges[compactEdge.origin] = index;
+
+			if (compactEdge.twin == NO_INDEX)
+				closed = false;
+
+			edge = edge->next;
+		} while (edge != faces[i]->edge);
+	}
+
+	for (unsigned i = 0; i < edges.size(); i++)
+	{
+		if (edges[i].twin == NO_INDEX || i < edges[i].twin)
+		{
+			uniqueEdges.push_back(i);
+			uniqueEdgeDirections.push_back(glm::normalize(getEdgeVector(i)));
+		}
+	}
+
+	// cosine of angle under which normals are considered opposite
+	constexpr float oppositeTolerance = 0.99999f;
+
+	for (unsigned i = 0; i < facePlanes.size(); i++)
+	{
+		bool paired = false;
+
+		for (auto & axis : faceAxes)
+		{
+			if (axis.negativeFace == NO_INDEX && glm::dot(axis.normal, facePlanes[i].normal) < -oppositeTolerance)
+			{
+				axis.negativeFace = i;
+				paired = true;
+				break;
+			}
+		}
+
+		if (!paired)
+		{
+			FaceAxis axis = { facePlanes[i].normal, (uint16_t)i, NO_INDEX };
+			faceAxes.push_back(axis);
+		}
+	}
+
+	return true;
+}
+
+unsigned CompactHull::findExtremeVertex(const glm::vec3& direction, unsigned start) const
+{
+	unsigned vertexCount = vertexX.size();
+
+	if (!closed)
+	{
+		// edges don't connect whole hull
+		unsigned extreme = 0;
+		float maxProjection = -FLT_MAX;
+
+		for (unsigned i = 0; i < vertexCount; i++)
+		{
+			float projection = vertexX[i] * direction.x + vertexY[i] * direction.y + vertexZ[i] * direction.z;
+			if (projection > maxProjection)
+			{
+				maxProjection = projection;
+				extreme = i;
+			}
+		}
+		return extreme;
+	}
+
+	if (start >= vertexCount || vertexEdges[start] == NO_INDEX)
+	{
+		// vertices inside merged faces have no edges
+		start = edges[0].origin;
+	}
+
+	unsigned current = start;
+	float maxProjection = glm::dot(getVertex(current), direction);
+	bool improved = true;
+
+	// on convex hull, vertex without better neighbour is the most extreme one
+	while (improved)
+	{
+		improved = false;
+		unsigned firstEdge = vertexEdges[current];
+		unsigned edge = firstEdge;
+
+		do
+		{
+			unsigned head = getHead(edge);
+			float projection = glm::dot(getVertex(head), direction);
+			if (projection > maxProjection)
+			{
+				maxProjection = projection;
+				current = head;
+				improved = true;
+				break;
+			}
+			edge = edges[edges[edge].twin].next;
+		} while (edge != firstEdge);
+	}
+
+	return current;
+}
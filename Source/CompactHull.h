@@ -0,0 +1,125 @@
+/**
+ * Bakalarska praca - Simualace pevnych teles
+ * VUT FIT, 2018/2019
+ *
+ * Autor:	Denis Leitner, xleitn02
+ * Subor:	CompactHull.h
+ *
+ */
+
+#pragma once
+
+#ifndef COMPACT_HULL_H
+#define COMPACT_HULL_H
+
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <vector>
+
+#include "HalfEdge.h"
+
+// index of missing vertex, edge or face
+constexpr uint16_t NO_INDEX = 0xFFFF;
+// number of direction octants for which last support vertex of an object is kept
+constexpr unsigned SUPPORT_CACHE_SLOTS = 8;
+// number of hulls for which a sphere keeps the face closest to its centre
+constexpr unsigned CLOSEST_FACE_SLOTS = 4;
+// largest number of vertices of one face, faces are clipped in buffers of fixed size
+constexpr unsigned MAX_FACE_VERTICES = 64;
+
+/**
+ * @brief Half edge of compact hull, all references are indices into arrays of the hull
+ */
+struct CompactHalfEdge
+{
+	uint16_t origin;	// tail vertex
+	uint16_t twin;		// twin edge, NO_INDEX if edge has no twin
+	uint16_t next;		// next edge in face
+	uint16_t face;		// face into which edge belongs
+};
+
+/**
+ * @brief Face normal direction tested as separating axis, faces with opposite normals share one axis
+ */
+struct FaceAxis
+{
+	glm::vec3 normal;			// normal of the positive face in local space
+	uint16_t positiveFace;		// face with the normal
+	uint16_t negativeFace;		// face with opposite normal, NO_INDEX if hull has no such face
+};
+
+/**
+ * @brief Half-edge mesh of hull stored in contiguous arrays, used by narrow phase
+ */
+class CompactHull
+{
+public:
+	// vertex positions in local space, structure of arrays
+	std::vector<float> vertexX;
+	std::vector<float> vertexY;
+	std::vector<float> vertexZ;
+	// one edge going out of every vertex, NO_INDEX for vertices inside merged faces
+	std::vector<uint16_t> vertexEdges;
+
+	std::vector<CompactHalfEdge> edges;
+	// one half-edge of each pair of twins, edges without twin included
+	std::vector<uint16_t> uniqueEdges;
+	// normalized directions of unique edges in local space
+	std::vector<glm::vec3> uniqueEdgeDirections;
+
+	// one edge of every face
+	std::vector<uint16_t> faceEdges;
+	// face planes in local space
+	std::vector<Plane> facePlanes;
+	// distinct separating axes given by face normals
+	std::vector<FaceAxis> faceAxes;
+
+	// whether every edge has twin, hill-climbing can be used only on closed hull
+	bool closed;
+
+	CompactHull();
+
+	/**
+	 * @brief Builds compact hull from half-edge mesh
+	 * @param vertices Vertices of the mesh
+	 * @param faces Faces of the mesh, their edge loops contain all edges
+	 * @return Whether hull could be built, false if it has too many elements for 16-bit indices
+	 *         or face with more than MAX_FACE_VERTICES vertices
+	 */
+	bool build(const std::vector<heVertex*>& vertices, const std::vector<heFace*>& faces);
+
+	/**
+	 * @brief Gets position of vertex in local space
+	 */
+	inline glm::vec3 getVertex(unsigned vertex) const
+	{
+		return glm::vec3(vertexX[vertex], vertexY[vertex], vertexZ[vertex]);
+	}
+
+	/**
+	 * @brief Gets index of head vertex of an edge
+	 */
+	inline unsigned getHead(unsigned edge) const
+	{
+		return edges[edges[edge].next].origin;
+	}
+
+	/**
+	 * @brief Gets vector from tail to head of an edge in local space
+	 */
+	inline glm::vec3 getEdgeVector(unsigned edge) const
+	{
+		return getVertex(getHead(edge)) - getVertex(edges[edge].origin);
+	}
+
+	/**
+	 * @brief Finds vertex that is most extreme in given direction by walking over edges from start vertex
+	 *        to neighbour vertices that are further in that direction, whole hull is searched if it isn't closed
+	 * @param direction Direction in local space
+	 * @param start Vertex from which to start, NO_INDEX to start from any vertex
+	 * @return Index of the most extreme vertex
+	 */
+	unsigned findExtremeVertex(const glm::vec3& direction, unsigned start) const;
+};
+
+#endif
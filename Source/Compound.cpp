@@ -0,0 +1,159 @@
+/**
+ * Bakalarska praca - Simualace pevnych teles
+ * VUT FIT, 2018/2019
+ *
+ * Autor:	Denis Leitner, xleitn02
+ * Subor:	Compound.cpp
+ *
+ */
+
+#include "Compound.h"
+#include "Object.h"
+#include <algorithm>
+
+
+Compound::Compound()
+{
+	type = compound;
+}
+
+bool Compound::addChild(Model* model, const glm::vec3& position, const glm::mat3& rotation)
+{
+	ShapeType childType = model->shape->type;
+
+	if ((childType != hull && childType != box && childType != sphere) || children.size() >= MAX_COMPOUND_CHILDREN)
+		return false;
+
+	// local AABB of the child model rotated into space of the compound
+	glm::vec3 center = rotation * model->localCenter + position;
+	glm::vec3 halfExtents = glm::abs(rotation[0]) * model->localHalfExtents.x
+		+ glm::abs(rotation[1]) * model->localHalfExtents.y
+		+ glm::abs(rotation[2]) * model->localHalfExtents.z;
+
+	CompoundChild child = { model, rotation, position, center - halfExtents, center + halfExtents };
+	children.push_back(child);
+
+	uint16_t indices[MAX_COMPOUND_CHILDREN];
+	for (unsigned i = 0; i < children.size(); i++)
+		indices[i] = i;
+
+	nodes.clear();
+	buildNode(indices, children.size());
+
+	return true;
+}
+
+void Compound::buildNode(uint16_t* indices, unsigned count)
+{
+	unsigned nodeIndex = nodes.size();
+	nodes.push_back(CompoundNode());
+
+	glm::vec3 min = children[indices[0]].boundsMin;
+	glm::vec3 max = children[indices[0]].boundsMax;
+
+	for (unsigned i = 1; i < count; i++)
+	{
+		min = glm::min(min, children[indices[i]].boundsMin);
+		max = glm::max(max, children[indices[i]].boundsMax);
+	}
+
+	nodes[nodeIndex].min = min;
+	nodes[nodeIndex].max = max;
+
+	if (count == 1)
+	{
+		nodes[nodeIndex].child = indices[0];
+		return;
+	}
+
+	glm::vec3 extents = max - min;
+	int axis = 0;
+	if (extents.y > extents[axis])
+		axis = 1;
+	if (extents.z > extents[axis])
+		axis = 2;
+
+	// half of children with lower centres go to the left subtree
+	unsigned half = count / 2;
+	std::nth_element(indices, indices + half, indices + count, [this, axis](uint16_t a, uint16_t b)
+	{
+		return children[a].boundsMin[axis] + children[a].boundsMax[axis] < children[b].boundsMin[axis] + children[b].boundsMax[axis];
+	});
+
+	nodes[nodeIndex].child = MAX_COMPOUND_CHILDREN;
+	buildNode(indices, half);
+	nodes[nodeIndex].right = nodes.size();
+	buildNode(indices + half, count - half);
+}
+
+unsigned Compound::findChildren(const glm::vec3& min, const glm::vec3& max, uint16_t* found) const
+{
+	unsigned count = 0;
+
+	if (nodes.empty())
+		return 0;
+
+	// depth of balanced hierarchy is at most log2(MAX_COMPOUND_CHILDREN) + 1
+	uint16_t stack[MAX_COMPOUND_CHILDREN];
+	unsigned stackSize = 0;
+	stack[stackSize++] = 0;
+
+	while (stackSize > 0)
+	{
+		unsigned index = stack[--stackSize];
+		const CompoundNode& node = nodes[index];
+
+		if (node.min.x > max.x || node.max.x < min.x
+			|| node.min.y > max.y || node.max.y < min.y
+			|| node.min.z > max.z || node.max.z < min.z)
+			continue;
+
+		if (node.child != MAX_COMPOUND_CHILDREN)
+		{
+			found[count++] = node.child;
+			continue;
+		}
+
+		stack[stackSize++] = node.right;
+		stack[stackSize++] = index + 1;
+	}
+
+	return count;
+}
+
+void Compound::calculateAttributes(Object* object)
+{
+	float mass = 0.0f;
+	glm::vec3 weightedCenters = glm::vec3(0.0f);
+
+	// centres of mass of children in local space of the compound
+	std::vector<glm::vec3> centers(children.size());
+
+	for (unsigned i = 0; i < children.size(); i++)
+	{
+		Object* part = object->parts[i];
+		centers[i] = children[i].rotation * part->centerOfMass + children[i].position;
+
+		mass += part->mass;
+		weightedCenters += part->mass * centers[i];
+	}
+
+	glm::vec3 centerOfMass = weightedCenters / mass;
+	glm::mat3 inertia = glm::mat3(0.0f);
+
+	for (unsigned i = 0; i < children.size(); i++)
+	{
+		Object* part = object->parts[i];
+		const glm::mat3& rotation = children[i].rotation;
+
+		// inertia of the child rotated into space of the compound and moved to its centre of mass
+		glm::vec3 offset = centers[i] - centerOfMass;
+		glm::mat3 shift = glm::mat3(glm::dot(offset, offset)) - glm::outerProduct(offset, offset);
+		inertia += rotation * glm::inverse(part->inverseBodyInertiaTensor) * glm::transpose(rotation) + part->mass * shift;
+	}
+
+	object->centerOfMass = centerOfMass;
+	object->mass = mass;
+	object->inverseMass = 1.0f / mass;
+	object->inverseBodyInertiaTensor = glm::inverse(inertia);
+}
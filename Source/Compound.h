@@ -0,0 +1,93 @@
+/**
+ * Bakalarska praca - Simualace pevnych teles
+ * VUT FIT, 2018/2019
+ *
+ * Autor:	Denis Leitner, xleitn02
+ * Subor:	Compound.h
+ *
+ */
+
+#pragma once
+
+#ifndef COMPOUND_H
+#define COMPOUND_H
+
+#include <glm/glm.hpp>
+#include <vector>
+
+#include "Model.h"
+#include "Shape.h"
+
+// upper limit of children of one compound, children found by one query fit into array of this size
+constexpr unsigned MAX_COMPOUND_CHILDREN = 64;
+
+/**
+ * @brief Convex child of compound shape, placed in local space of the compound
+ */
+struct CompoundChild
+{
+	Model* model;			// model of the child, hull or sphere
+	glm::mat3 rotation;		// rotation of the child in local space of the compound
+	glm::vec3 position;		// position of the child in local space of the compound
+	glm::vec3 boundsMin;	// AABB of the child in local space of the compound
+	glm::vec3 boundsMax;
+};
+
+/**
+ * @brief Node of bounding volume hierarchy of children, the left child of inner node follows it in array
+ */
+struct CompoundNode
+{
+	glm::vec3 min;			// AABB of all children under the node
+	glm::vec3 max;
+	uint16_t right;			// index of the right child node, valid only for inner nodes
+	uint16_t child;			// index of compound child for leaves, MAX_COMPOUND_CHILDREN for inner nodes
+};
+
+/**
+ * @brief Shape made of convex children, used for concave objects; children are models of other shapes
+ */
+class Compound : public Shape
+{
+public:
+	std::vector<CompoundChild> children;
+
+	Compound();
+
+	/**
+	 * @brief Adds convex child and rebuilds hierarchy of children
+	 * @param model Model of the child, must be hull or sphere
+	 * @param position Position of the child in local space of the compound
+	 * @param rotation Rotation of the child in local space of the compound
+	 * @return Whether child was added, false for other shapes or if there are too many children
+	 */
+	bool addChild(Model* model, const glm::vec3& position, const glm::mat3& rotation);
+
+	/**
+	 * @brief Finds children whose bounds overlap given box
+	 * @param min Minimal corner of the box in local space of the compound
+	 * @param max Maximal corner of the box in local space of the compound
+	 * @param[out] found Indices of found children, array of MAX_COMPOUND_CHILDREN elements
+	 * @return Number of found children
+	 */
+	unsigned findChildren(const glm::vec3& min, const glm::vec3& max, uint16_t* found) const;
+
+	/**
+	 * @brief Sums mass, centre of mass and inertia tensor of children,
+	 *        objects of children must already have their attributes calculated
+	 */
+	void calculateAttributes(Object* object) override;
+
+private:
+	// hierarchy of children, root is the first node
+	std::vector<CompoundNode> nodes;
+
+	/**
+	 * @brief Builds subtree over children by splitting them by centres of their bounds along the longest axis
+	 * @param indices Indices of children of the subtree, reordered during build
+	 * @param count Number of children of the subtree
+	 */
+	void buildNode(uint16_t* indices, unsigned count);
+};
+
+#endif
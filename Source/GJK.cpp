@@ -0,0 +1,527 @@
+/**
+ * Bakalarska praca - Simualace pevnych teles
+ * VUT FIT, 2018/2019
+ *
+ * Autor:	Denis Leitner, xleitn02
+ * Subor:	GJK.cpp
+ *
+ */
+
+#include "GJK.h"
+#include <algorithm>
+#include <cfloat>
+#include <utility>
+
+
+GJK::GJK(Object* object0, Object* object1)
+{
+	hull0 = static_cast<Hull*>(object0->model->shape);
+	hull1 = static_cast<Hull*>(object1->model->shape);
+	transformationMatrix0 = object0->getModelMatrix();
+	transformationMatrix1 = object1->getModelMatrix();
+	supportCache0 = object0->supportVertices;
+	supportCache1 = object1->supportVertices;
+	centerDirection = object0->getPosition() - object1->getPosition();
+	simplexSize = 0;
+}
+
+bool GJK::computeDistance(float& distance, glm::vec3& point0, glm::vec3& point1)
+{
+	// Minkowski difference lies around difference of centres, its part nearest to origin is in opposite direction
+	glm::vec3 direction = -centerDirection;
+	if (glm::dot(direction, direction) < EPSILON * EPSILON)
+		direction = glm::vec3(1.0f, 0.0f, 0.0f);
+
+	simplex[0] = getSupport(direction);
+	barycentric[0] = 1.0f;
+	simplexSize = 1;
+
+	glm::vec3 closest = simplex[0].point;
+
+	for (unsigned i = 0; i < GJK_MAX_ITERATIONS; i++)
+	{
+		float closestDistance2 = glm::dot(closest, closest);
+
+		if (closestDistance2 < GJK_INTERSECTION_DISTANCE * GJK_INTERSECTION_DISTANCE)
+		{
+			// origin lies in the simplex
+			return false;
+		}
+
+		SupportPoint support = getSupport(-closest);
+
+		if (closestDistance2 - glm::dot(closest, support.point) <= GJK_TOLERANCE * closestDistance2)
+		{
+			// no point of Minkowski difference is noticeably closer to origin
+			break;
+		}
+
+		simplex[simplexSize++] = support;
+		closest = solveSimplex();
+
+		if (simplexSize == 4)
+		{
+			// origin is inside of tetrahedron
+			return false;
+		}
+	}
+
+	point0 = glm::vec3(0.0f);
+	point1 = glm::vec3(0.0f);
+
+	for (unsigned i = 0; i < simplexSize; i++)
+	{
+		point0 += barycentric[i] * simplex[i].support0;
+		point1 += barycentric[i] * simplex[i].support1;
+	}
+
+	distance = glm::length(closest);
+	return true;
+}
+
+bool GJK::computePenetration(glm::vec3& normal, float& depth, glm::vec3& point)
+{
+	if (simplexSize < 4 && !completeSimplex())
+		return false;
+
+	// polytope is held on stack, its size is bounded by number of iterations
+	SupportPoint vertices[EPA_MAX_VERTICES];
+	PolytopeFace faces[EPA_MAX_FACES];
+	std::pair<unsigned, unsigned> horizon[EPA_MAX_HORIZON_EDGES];
+	unsigned vertexCount = 4;
+	unsigned faceCount = 0;
+	unsigned horizonCount = 0;
+
+	std::copy(simplex, simplex + 4, vertices);
+
+	// first face must be counter-clockwise when viewed from outside, i.e. fourth vertex is behind it
+	glm::vec3 firstNormal = glm::cross(vertices[1].point - vertices[0].point, vertices[2].point - vertices[0].point);
+	if (glm::dot(firstNormal, vertices[3].point - vertices[0].point) > 0.0f)
+		std::swap(vertices[1], vertices[2]);
+
+	const unsigned tetrahedronFaces[4][3] = { { 0, 1, 2 }, { 0, 3, 1 }, { 0, 2, 3 }, { 1, 3, 2 } };
+
+	for (auto & indices : tetrahedronFaces)
+	{
+		if (!createFace(vertices, indices[0], indices[1], indices[2], faces[faceCount]))
+			return false;
+		faceCount++;
+	}
+
+	unsigned closestFace = 0;
+
+	for (unsigned iteration = 0; iteration <= EPA_MAX_ITERATIONS; iteration++)
+	{
+		closestFace = 0;
+		for (unsigned i = 1; i < faceCount; i++)
+		{
+			if (faces[i].distance < faces[closestFace].distance)
+				closestFace = i;
+		}
+
+		if (iteration == EPA_MAX_ITERATIONS)
+		{
+			// not converged, closest face is used as approximation
+			break;
+		}
+
+		PolytopeFace face = faces[closestFace];
+		SupportPoint support = getSupport(face.normal);
+
+		if (glm::dot(support.point, face.normal) - face.distance < EPA_TOLERANCE)
+		{
+			// face is on boundary of Minkowski difference
+			break;
+		}
+
+		unsigned newVertex = vertexCount;
+		vertices[vertexCount++] = support;
+
+		// remove faces visible from new vertex, their boundary forms horizon
+		horizonCount = 0;
+		for (unsigned i = 0; i < faceCount; )
+		{
+			if (glm::dot(faces[i].normal, support.point - vertices[faces[i].vertices[0]].point) <= 0.0f)
+			{
+				i++;
+				continue;
+			}
+
+			for (unsigned j = 0; j < 3; j++)
+			{
+				std::pair<unsigned, unsigned> edge(faces[i].vertices[j], faces[i].vertices[(j + 1) % 3]);
+				auto twin = std::find(horizon, horizon + horizonCount, std::make_pair(edge.second, edge.first));
+
+				if (twin != horizon + horizonCount)
+				{
+					// edge is shared by 2 removed faces
+					*twin = horizon[--horizonCount];
+				}
+				else
+				{
+					// polytope isn't closed mesh because of rounding errors
+					if (horizonCount == EPA_MAX_HORIZON_EDGES)
+						return false;
+
+					horizon[horizonCount++] = edge;
+				}
+			}
+
+			faces[i] = faces[--faceCount];
+		}
+
+		if (faceCount + horizonCount > EPA_MAX_FACES)
+			return false;
+
+		for (unsigned i = 0; i < horizonCount; i++)
+		{
+			if (!createFace(vertices, horizon[i].first, horizon[i].second, newVertex, faces[faceCount]))
+				return false;
+			faceCount++;
+		}
+	}
+
+	const PolytopeFace& face = faces[closestFace];
+	const SupportPoint& a = vertices[face.vertices[0]];
+	const SupportPoint& b = vertices[face.vertices[1]];
+	const SupportPoint& c = vertices[face.vertices[2]];
+
+	// barycentric coordinates of origin projected onto the face
+	glm::vec3 projection = face.normal * face.distance;
+	glm::vec3 v0 = b.point - a.point;
+	glm::vec3 v1 = c.point - a.point;
+	glm::vec3 v2 = projection - a.point;
+
+	float d00 = glm::dot(v0, v0);
+	float d01 = glm::dot(v0, v1);
+	float d11 = glm::dot(v1, v1);
+	float d20 = glm::dot(v2, v0);
+	float d21 = glm::dot(v2, v1);
+	float denominator = d00 * d11 - d01 * d01;
+
+	if (denominator == 0.0f)
+		return false;
+
+	float v = (d11 * d20 - d01 * d21) / denominator;
+	float w = (d00 * d21 - d01 * d20) / denominator;
+	float u = 1.0f - v - w;
+
+	glm::vec3 point0 = u * a.support0 + v * b.support0 + w * c.support0;
+	glm::vec3 point1 = u * a.support1 + v * b.support1 + w * c.support1;
+
+	// translating the first hull against face normal separates hulls
+	normal = -face.normal;
+	depth = face.distance;
+	point = (point0 + point1) / 2.0f;
+
+	return true;
+}
+
+SupportPoint GJK::getSupport(const glm::vec3& direction)
+{
+	SupportPoint result;
+	result.support0 = hull0->getSupport(direction, transformationMatrix0, supportCache0);
+	result.support1 = hull1->getSupport(-direction, transformationMatrix1, supportCache1);
+	result.point = result.support0 - result.support1;
+	return result;
+}
+
+glm::vec3 GJK::solveSimplex()
+{
+	switch (simplexSize)
+	{
+	case 2:
+		return solveSegment();
+	case 3:
+		return solveTriangle();
+	case 4:
+		return solveTetrahedron();
+	default:
+		barycentric[0] = 1.0f;
+		return simplex[0].point;
+	}
+}
+
+glm::vec3 GJK::solveSegment()
+{
+	glm::vec3 a = simplex[0].point;
+	glm::vec3 ab = simplex[1].point - a;
+
+	float length2 = glm::dot(ab, ab);
+	float t = length2 > 0.0f ? -glm::dot(a, ab) / length2 : 1.0f;
+
+	if (t <= 0.0f)
+	{
+		const unsigned indices[1] = { 0 };
+		const float weights[1] = { 1.0f };
+		return reduceSimplex(indices, weights, 1);
+	}
+
+	if (t >= 1.0f)
+	{
+		const unsigned indices[1] = { 1 };
+		const float weights[1] = { 1.0f };
+		return reduceSimplex(indices, weights, 1);
+	}
+
+	const unsigned indices[2] = { 0, 1 };
+	const float weights[2] = { 1.0f - t, t };
+	return reduceSimplex(indices, weights, 2);
+}
+
+/**
+ * Algorithm from Real-Time Collision Detection, chapter 5.1.5
+ * Author: Christer Ericson
+ */
+glm::vec3 GJK::solveTriangle()
+{
+	glm::vec3 a = simplex[0].point;
+	glm::vec3 b = simplex[1].point;
+	glm::vec3 c = simplex[2].point;
+
+	glm::vec3 ab = b - a;
+	glm::vec3 ac = c - a;
+
+	// vertex region of a
+	float d1 = glm::dot(ab, -a);
+	float d2 = glm::dot(ac, -a);
+	if (d1 <= 0.0f && d2 <= 0.0f)
+	{
+		const unsigned indices[1] = { 0 };
+		const float weights[1] = { 1.0f };
+		return reduceSimplex(indices, weights, 1);
+	}
+
+	// vertex region of b
+	float d3 = glm::dot(ab, -b);
+	float d4 = glm::dot(ac, -b);
+	if (d3 >= 0.0f && d4 <= d3)
+	{
+		const unsigned indices[1] = { 1 };
+		const float weights[1] = { 1.0f };
+		return reduceSimplex(indices, weights, 1);
+	}
+
+	// edge region of ab
+	float vc = d1 * d4 - d3 * d2;
+	if (vc <= 0.0f && d1 >= 0.0f && d3 <= 0.0f)
+	{
+		float v = d1 / (d1 - d3);
+		const unsigned indices[2] = { 0, 1 };
+		const float weights[2] = { 1.0f - v, v };
+		return reduceSimplex(indices, weights, 2);
+	}
+
+	// vertex region of c
+	float d5 = glm::dot(ab, -c);
+	float d6 = glm::dot(ac, -c);
+	if (d6 >= 0.0f && d5 <= d6)
+	{
+		const unsigned indices[1] = { 2 };
+		const float weights[1] = { 1.0f };
+		return reduceSimplex(indices, weights, 1);
+	}
+
+	// edge region of ac
+	float vb = d5 * d2 - d1 * d6;
+	if (vb <= 0.0f && d2 >= 0.0f && d6 <= 0.0f)
+	{
+		float w = d2 / (d2 - d6);
+		const unsigned indices[2] = { 0, 2 };
+		const float weights[2] = { 1.0f - w, w };
+		return reduceSimplex(indices, weights, 2);
+	}
+
+	// edge region of bc
+	float va = d3 * d6 - d5 * d4;
+	if (va <= 0.0f && (d4 - d3) >= 0.0f && (d5 - d6) >= 0.0f)
+	{
+		float w = (d4 - d3) / ((d4 - d3) + (d5 - d6));
+		const unsigned indices[2] = { 1, 2 };
+		const float weights[2] = { 1.0f - w, w };
+		return reduceSimplex(indices, weights, 2);
+	}
+
+	// face region
+	float denominator = va + vb + vc;
+	if (denominator <= 0.0f)
+	{
+		// degenerate triangle, keep its newest vertex
+		const unsigned indices[1] = { 2 };
+		const float weights[1] = { 1.0f };
+		return reduceSimplex(indices, weights, 1);
+	}
+
+	float v = vb / denominator;
+	float w = vc / denominator;
+	const unsigned indices[3] = { 0, 1, 2 };
+	const float weights[3] = { 1.0f - v - w, v, w };
+	return reduceSimplex(indices, weights, 3);
+}
+
+glm::vec3 GJK::solveTetrahedron()
+{
+	// vertices of each face followed by opposite vertex
+	const unsigned faces[4][4] = { { 0, 1, 2, 3 }, { 0, 3, 1, 2 }, { 0, 2, 3, 1 }, { 1, 3, 2, 0 } };
+
+	SupportPoint tetrahedron[4] = { simplex[0], simplex[1], simplex[2], simplex[3] };
+
+	SupportPoint bestSimplex[3];
+	float bestBarycentric[3];
+	unsigned bestSize = 0;
+	glm::vec3 bestPoint = glm::vec3(0.0f);
+	float bestDistance2 = FLT_MAX;
+
+	for (auto & face : faces)
+	{
+		const glm::vec3& a = tetrahedron[face[0]].point;
+		glm::vec3 normal = glm::cross(tetrahedron[face[1]].point - a, tetrahedron[face[2]].point - a);
+
+		float originSide = glm::dot(-a, normal);
+		float oppositeSide = glm::dot(tetrahedron[face[3]].point - a, normal);
+
+		// faces of flat tetrahedron are always tested, it has no inside
+		bool flat = std::abs(oppositeSide) <= GJK_INTERSECTION_DISTANCE * glm::length(normal);
+
+		if (!flat && originSide * oppositeSide >= 0.0f)
+		{
+			// origin is on the same side of the face as the rest of tetrahedron
+			continue;
+		}
+
+		simplex[0] = tetrahedron[face[0]];
+		simplex[1] = tetrahedron[face[1]];
+		simplex[2] = tetrahedron[face[2]];
+		simplexSize = 3;
+
+		glm::vec3 point = solveTriangle();
+		float distance2 = glm::dot(point, point);
+
+		if (distance2 < bestDistance2)
+		{
+			bestDistance2 = distance2;
+			bestPoint = point;
+			bestSize = simplexSize;
+			std::copy(simplex, simplex + simplexSize, bestSimplex);
+			std::copy(barycentric, barycentric + simplexSize, bestBarycentric);
+		}
+	}
+
+	if (bestSize == 0)
+	{
+		// origin is inside of tetrahedron
+		std::copy(tetrahedron, tetrahedron + 4, simplex);
+		simplexSize = 4;
+		return glm::vec3(0.0f);
+	}
+
+	std::copy(bestSimplex, bestSimplex + bestSize, simplex);
+	std::copy(bestBarycentric, bestBarycentric + bestSize, barycentric);
+	simplexSize = bestSize;
+
+	return bestPoint;
+}
+
+glm::vec3 GJK::reduceSimplex(const unsigned* indices, const float* weights, unsigned count)
+{
+	SupportPoint reduced[4];
+	glm::vec3 point = glm::vec3(0.0f);
+
+	for (unsigned i = 0; i < count; i++)
+	{
+		reduced[i] = simplex[indices[i]];
+		point += weights[i] * reduced[i].point;
+	}
+
+	for (unsigned i = 0; i < count; i++)
+	{
+		simplex[i] = reduced[i];
+		barycentric[i] = weights[i];
+	}
+	simplexSize = count;
+
+	return point;
+}
+
+bool GJK::completeSimplex()
+{
+	const glm::vec3 axes[6] = {
+		glm::vec3(1.0f, 0.0f, 0.0f), glm::vec3(-1.0f, 0.0f, 0.0f),
+		glm::vec3(0.0f, 1.0f, 0.0f), glm::vec3(0.0f, -1.0f, 0.0f),
+		glm::vec3(0.0f, 0.0f, 1.0f), glm::vec3(0.0f, 0.0f, -1.0f)
+	};
+
+	if (simplexSize == 1)
+	{
+		// any point different from the first one
+		for (auto & axis : axes)
+		{
+			SupportPoint support = getSupport(axis);
+			glm::vec3 difference = support.point - simplex[0].point;
+
+			if (glm::dot(difference, difference) > EPSILON * EPSILON)
+			{
+				simplex[simplexSize++] = support;
+				break;
+			}
+		}
+	}
+
+	if (simplexSize == 2)
+	{
+		// any point off the line of the segment
+		glm::vec3 segment = simplex[1].point - simplex[0].point;
+
+		for (auto & axis : axes)
+		{
+			glm::vec3 direction = glm::cross(segment, axis);
+			if (glm::dot(direction, direction) < EPSILON * EPSILON)
+				continue;
+
+			SupportPoint support = getSupport(direction);
+			glm::vec3 offset = glm::cross(support.point - simplex[0].point, segment);
+
+			if (glm::dot(offset, offset) > EPSILON * EPSILON)
+			{
+				simplex[simplexSize++] = support;
+				break;
+			}
+		}
+	}
+
+	if (simplexSize == 3)
+	{
+		// any point off the plane of the triangle
+		glm::vec3 normal = glm::cross(simplex[1].point - simplex[0].point, simplex[2].point - simplex[0].point);
+
+		for (float sign : { 1.0f, -1.0f })
+		{
+			SupportPoint support = getSupport(sign * normal);
+
+			if (std::abs(glm::dot(support.point - simplex[0].point, normal)) > EPSILON * EPSILON)
+			{
+				simplex[simplexSize++] = support;
+				break;
+			}
+		}
+	}
+
+	return simplexSize == 4;
+}
+
+bool GJK::createFace(const SupportPoint* vertices, unsigned a, unsigned b, unsigned c, PolytopeFace& face)
+{
+	glm::vec3 normal = glm::cross(vertices[b].point - vertices[a].point, vertices[c].point - vertices[a].point);
+	float length = glm::length(normal);
+
+	if (length < EPSILON * EPSILON)
+		return false;
+
+	face.vertices[0] = a;
+	face.vertices[1] = b;
+	face.vertices[2] = c;
+	face.normal = normal / length;
+	face.distance = glm::dot(face.normal, vertices[a].point);
+
+	return true;
+}
@@ -0,0 +1,150 @@
+/**
+ * Bakalarska praca - Simualace pevnych teles
+ * VUT FIT, 2018/2019
+ *
+ * Autor:	Denis Leitner, xleitn02
+ * Subor:	GJK.h
+ *
+ */
+
+#pragma once
+
+#ifndef GJK_H
+#define GJK_H
+
+#include <glm/glm.hpp>
+
+#include "Hull.h"
+#include "Object.h"
+
+constexpr unsigned GJK_MAX_ITERATIONS = 32;
+// relative improvement of distance under which GJK stops
+constexpr float GJK_TOLERANCE = 0.0001f;
+// distance under which objects are considered intersecting
+constexpr float GJK_INTERSECTION_DISTANCE = 0.00001f;
+constexpr unsigned EPA_MAX_ITERATIONS = 64;
+// polytope starts as tetrahedron and gets one vertex per iteration, it is held in arrays of fixed size
+constexpr unsigned EPA_MAX_VERTICES = 4 + EPA_MAX_ITERATIONS;
+// closed triangle mesh with V vertices has 2V - 4 faces and 3V - 6 edges
+constexpr unsigned EPA_MAX_FACES = 2 * EPA_MAX_VERTICES - 4;
+constexpr unsigned EPA_MAX_HORIZON_EDGES = 3 * EPA_MAX_VERTICES - 6;
+// growth of polytope under which EPA stops
+constexpr float EPA_TOLERANCE = 0.0001f;
+
+/**
+ * @brief Point of Minkowski difference of 2 hulls together with points of hulls it was created from
+ */
+struct SupportPoint
+{
+	glm::vec3 point;		// support0 - support1
+	glm::vec3 support0;		// point of the first hull in world space
+	glm::vec3 support1;		// point of the second hull in world space
+};
+
+/**
+ * @brief Distance and penetration queries of 2 convex hulls, GJK computes distance,
+ *        EPA computes penetration depth of intersecting hulls from the last GJK simplex
+ */
+class GJK
+{
+public:
+	GJK(Object* object0, Object* object1);
+
+	/**
+	 * @brief Computes distance of hulls and their closest points by GJK
+	 * @param[out] distance Distance of hulls
+	 * @param[out] point0 Closest point of the first hull in world space
+	 * @param[out] point1 Closest point of the second hull in world space
+	 * @return Whether hulls are separated, outputs are valid only if they are
+	 */
+	bool computeDistance(float& distance, glm::vec3& point0, glm::vec3& point1);
+
+	/**
+	 * @brief Computes penetration of intersecting hulls by EPA, must follow computeDistance that found intersection
+	 * @param[out] normal Collision normal pointing from the second hull to the first one
+	 * @param[out] depth Penetration depth
+	 * @param[out] point Contact point in world space
+	 * @return Whether penetration could be computed, false for degenerate cases
+	 */
+	bool computePenetration(glm::vec3& normal, float& depth, glm::vec3& point);
+
+private:
+
+	/**
+	 * @brief Triangle of EPA polytope, vertices are ordered counter-clockwise when viewed from outside
+	 */
+	struct PolytopeFace
+	{
+		unsigned vertices[3];
+		glm::vec3 normal;		// outer normal
+		float distance;			// distance of face plane from origin
+	};
+
+	Hull* hull0;
+	Hull* hull1;
+	glm::mat4 transformationMatrix0;
+	glm::mat4 transformationMatrix1;
+	// support vertices of objects kept between queries
+	uint16_t* supportCache0;
+	uint16_t* supportCache1;
+	glm::vec3 centerDirection;		// direction from the second object to the first one
+
+	// current simplex and barycentric coordinates of its point closest to origin
+	SupportPoint simplex[4];
+	float barycentric[4];
+	unsigned simplexSize;
+
+	/**
+	 * @brief Finds support point of Minkowski difference of hulls
+	 * @param direction Direction in world space
+	 * @return Support point
+	 */
+	SupportPoint getSupport(const glm::vec3& direction);
+
+	/**
+	 * @brief Finds point of simplex closest to origin, simplex is reduced to the smallest feature containing it
+	 * @return Closest point
+	 */
+	glm::vec3 solveSimplex();
+
+	/**
+	 * @brief Finds point of simplex segment closest to origin
+	 */
+	glm::vec3 solveSegment();
+
+	/**
+	 * @brief Finds point of simplex triangle closest to origin
+	 */
+	glm::vec3 solveTriangle();
+
+	/**
+	 * @brief Finds point of simplex tetrahedron closest to origin
+	 */
+	glm::vec3 solveTetrahedron();
+
+	/**
+	 * @brief Replaces simplex with its subset
+	 * @param indices Indices of vertices that are kept
+	 * @param weights Barycentric coordinates of kept vertices
+	 * @param count Number of kept vertices
+	 * @return Point of the new simplex given by its barycentric coordinates
+	 */
+	glm::vec3 reduceSimplex(const unsigned* indices, const float* weights, unsigned count);
+
+	/**
+	 * @brief Adds vertices to simplex of objects touching in a point, edge or face, so that it becomes tetrahedron
+	 * @return Whether tetrahedron was created
+	 */
+	bool completeSimplex();
+
+	/**
+	 * @brief Creates face of polytope
+	 * @param vertices Vertices of polytope
+	 * @param a, b, c Indices of face vertices, counter-clockwise when viewed from outside
+	 * @param[out] face Created face
+	 * @return Whether face isn't degenerate
+	 */
+	bool createFace(const SupportPoint* vertices, unsigned a, unsigned b, unsigned c, PolytopeFace& face);
+};
+
+#endif
@@ -1,132 +1,132 @@
-/**
- * Bakalarska praca - Simualace pevnych teles
- * VUT FIT, 2018/2019
- *
- * Autor:	Denis Leitner, xleitn02
- * Subor:	Grid.h
- *
- */
-
-#include "Grid.h"
-#include <glm/gtx/string_cast.hpp>
-#include <glm/common.hpp>
-
-
-Cell::Cell() = default;
-
-void Cell::clear()
-{
-	objects.clear();
-}
-
-Grid::Grid()
-{
-	try
-	{
-		cells = new Cell**[GRID_HEIGHT];
-		for (int i = 0; i < GRID_HEIGHT; i++)
-		{
-			cells[i] = new Cell*[GRID_WIDTH];
-			for (int j = 0; j < GRID_WIDTH; j++)
-				cells[i][j] = new Cell[GRID_DEPTH];
-		}
-	}
-	catch (std::bad_alloc)
-	{
-		std::cout << "Couldn't allocate memory for grid" << std::endl;
-		cells = NULL;
-	}
-}
-
-
-Grid::~Grid()
-{
-	for (int i = 0; i < GRID_HEIGHT; i++)
-	{
-		for (int j = 0; j < GRID_DEPTH; j++)
-			delete[] cells[i][j];
-		delete[] cells[i];
-	}
-	delete[] cells;
-}
-
-void Grid::insertObject(Object* object, const glm::uvec3& indices)
-{
-	Cell* cell = &(cells[indices.x][indices.y][indices.z]);
-	cell->objects.insert(object);
-	occupiedCells.insert(cell);
-}
-
-void Grid::insertStaticObject(Object* object, const glm::uvec3& indices)
-{
-	Cell* cell = &(cells[indices.x][indices.y][indices.z]);
-	cell->staticObjects.push_back(object);
-}
-
-void Grid::clearGrid()
-{
-	for (auto & cell : occupiedCells)
-	{
-		cell->clear();
-	}
-	occupiedCells.clear();
-}
-
-bool Grid::mapPositionToIndices(const glm::vec3& position, glm::uvec3& indices)
-{
-	// height index
-	if ((MIN_HEIGHT_COORD - CELL_SIZE > position.y) || (MAX_HEIGHT_COORD + CELL_SIZE < position.y))
-	{
-		// object is out of grid
-		return false;
-	}
-	else if ((MIN_HEIGHT_COORD > position.y) && (MIN_HEIGHT_COORD - CELL_SIZE < position.y))
-	{
-		// position is on the edge of being in the grid or out of grid
-		indices.x = 0;
-	}
-	else
-	{
-		indices.x = static_cast<unsigned int>((position.y - MIN_HEIGHT_COORD) / CELL_SIZE);
-
-		if (indices.x >= MAX_HEIGHT)
-		{
-			indices.x = MAX_HEIGHT;
-		}
-	}
-
-	// width index
-	if ((MIN_WIDTH_COORD - CELL_SIZE > position.x) || (MAX_WIDTH_COORD + CELL_SIZE < position.x))
-	{
-		// object is out of grid
-		return false;
-	}
-	else
-	{
-		indices.y = static_cast<unsigned int>((position.x - MIN_WIDTH_COORD) / CELL_SIZE);
-
-		if (indices.y >= MAX_WIDTH)
-		{
-			indices.y = MAX_WIDTH;
-		}
-	}
-	// depth index
-	if ((MIN_DEPTH_COORD - CELL_SIZE > position.z) || (MAX_DEPTH_COORD + CELL_SIZE < position.z))
-	{
-		// object is out of grid
-		return false;
-	}
-	else
-	{
-		indices.z = static_cast<unsigned int>((position.z - MIN_DEPTH_COORD) / CELL_SIZE);
-
-		if (indices.z >= MAX_DEPTH)
-		{
-			indices.z = MAX_DEPTH;
-		}
-	}
-
-	return true;
-}
-
-
+/**
+ * Bakalarska praca - Simualace pevnych teles
+ * VUT FIT, 2018/2019
+ *
+ * Autor:	Denis Leitner, xleitn02
+ * Subor:	Grid.h
+ *
+ */
+
+#include "Grid.h"
+#include <glm/gtx/string_cast.hpp>
+#include <glm/common.hpp>
+
+
+Cell::Cell() = default;
+
+void Cell::clear()
+{
+	objects.clear();
+}
+
+Grid::Grid(float cellSize, glm::uvec3 size, glm::vec3 origin)
+{
+	this->cellSize = cellSize;
+	this->size = size;
+	this->origin = origin;
+
+	try
+	{
+		cells = new Cell**[size.x];
+		for (unsigned i = 0; i < size.x; i++)
+		{
+			cells[i] = new Cell*[size.y];
+			for (unsigned j = 0; j < size.y; j++)
+				cells[i][j] = new Cell[size.z];
+		}
+	}
+	catch (std::bad_alloc)
+	{
+		std::cout << "Couldn't allocate memory for grid" << std::endl;
+		cells = NULL;
+	}
+}
+
+
+Grid::~Grid()
+{
+	if (cells == NULL)
+		return;
+
+	for (unsigned i = 0; i < size.x; i++)
+	{
+		for (unsigned j = 0; j < size.y; j++)
+			delete[] cells[i][j];
+		delete[] cells[i];
+	}
+	delete[] cells;
+}
+
+void Grid::insertObject(Object* object, const glm::uvec3& indices)
+{
+	Cell* cell = &(cells[indices.x][indices.y][indices.z]);
+	cell->objects.insert(object);
+	occupiedCells.insert(cell);
+}
+
+void Grid::insertStaticObject(Object* object, const glm::uvec3& indices)
+{
+	Cell* cell = &(cells[indices.x][indices.y][indices.z]);
+	cell->staticObjects.push_back(object);
+}
+
+void Grid::clearGrid()
+{
+	for (auto & cell : occupiedCells)
+	{
+		cell->clear();
+	}
+	occupiedCells.clear();
+}
+
+bool Grid::mapPositionToIndices(const glm::vec3& position, glm::uvec3& indices)
+{
+	// world-space axis of each index: height - y, width - x, depth - z
+	const int axes[3] = { 1, 0, 2 };
+
+	for (int i = 0; i < 3; i++)
+	{
+		float coordinate = position[axes[i]] - origin[axes[i]];
+		float extent = size[i] * cellSize;
+
+		if ((coordinate < -cellSize) || (coordinate > extent + cellSize))
+		{
+			// object is out of grid
+			return false;
+		}
+		else if (coordinate < 0.0f)
+		{
+			// position is on the edge of being in the grid or out of grid
+			indices[i] = 0;
+		}
+		else
+		{
+			indices[i] = static_cast<unsigned int>(coordinate / cellSize);
+
+			if (indices[i] >= size[i] - 1)
+			{
+				indices[i] = size[i] - 1;
+			}
+		}
+	}
+
+	return true;
+}
+
+bool Grid::mapAABBToIndices(AABB* aabb, glm::uvec3& minIndices, glm::uvec3& maxIndices)
+{
+	return mapPositionToIndices(aabb->min, minIndices) && mapPositionToIndices(aabb->max, maxIndices);
+}
+
+bool Grid::clampAABBToIndices(AABB* aabb, glm::uvec3& minIndices, glm::uvec3& maxIndices)
+{
+	glm::vec3 gridMax = origin + cellSize * glm::vec3(size.y, size.x, size.z);
+
+	if (glm::any(glm::greaterThan(aabb->min, gridMax)) || glm::any(glm::lessThan(aabb->max, origin)))
+	{
+		// AABB doesn't overlap the grid
+		return false;
+	}
+
+	return mapPositionToIndices(glm::max(aabb->min, origin), minIndices) && mapPositionToIndices(glm::min(aabb->max, gridMax), maxIndices);
+}
\ No newline at end of file
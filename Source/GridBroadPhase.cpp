@@ -0,0 +1,109 @@
+/**
+ * Bakalarska praca - Simualace pevnych teles
+ * VUT FIT, 2018/2019
+ *
+ * Autor:	Denis Leitner, xleitn02
+ * Subor:	GridBroadPhase.cpp
+ *
+ */
+
+#include "GridBroadPhase.h"
+
+
+GridBroadPhase::GridBroadPhase(const BroadPhaseSettings& settings)
+{
+	grid = new Grid(settings.cellSize, settings.gridSize, settings.gridOrigin);
+	if (grid->cells == NULL)
+	{
+		// memory for grid cells couldn't be allocated
+		delete grid;
+		grid = NULL;
+	}
+}
+
+GridBroadPhase::~GridBroadPhase()
+{
+	if (grid != NULL)
+		delete grid;
+}
+
+bool GridBroadPhase::insertStaticObject(Object* object)
+{
+	glm::uvec3 minIndices;
+	glm::uvec3 maxIndices;
+
+	// indices of min and max corner of the part of an object's AABB in the grid
+	if (!grid->clampAABBToIndices(object->aabb, minIndices, maxIndices))
+	{
+		// object is completely out of grid
+		return false;
+	}
+
+	// insert object into every cell it occupies
+	for (unsigned x = minIndices.x; x <= maxIndices.x; x++)
+		for (unsigned y = minIndices.y; y <= maxIndices.y; y++)
+			for (unsigned z = minIndices.z; z <= maxIndices.z; z++)
+			{
+				grid->insertStaticObject(object, glm::uvec3(x, y, z));
+			}
+	return true;
+}
+
+void GridBroadPhase::update(const std::vector<Object*>& objects)
+{
+	grid->clearGrid();
+	dynamicObjects = objects;
+	rejectedObjects = 0;
+}
+
+void GridBroadPhase::findPairs(std::vector<ObjectPair>& pairs)
+{
+	std::unordered_set<Object*> potentialCollisionObjects;
+
+	for (auto & object : dynamicObjects)
+	{
+		// indices to grid cell array of min and max corners of AABB
+		glm::uvec3 minIndices;
+		glm::uvec3 maxIndices;
+
+		if (!grid->mapAABBToIndices(object->aabb, minIndices, maxIndices))
+		{
+			// can't be inserted into grid
+			rejectedObjects++;
+			continue;
+		}
+
+		potentialCollisionObjects.clear();
+
+		// insert object into every cell it occupies
+		for (unsigned x = minIndices.x; x <= maxIndices.x; x++)
+			for (unsigned y = minIndices.y; y <= maxIndices.y; y++)
+				for (unsigned z = minIndices.z; z <= maxIndices.z; z++)
+				{
+					// potential collision partners
+					for (auto & potentialStaticObject : grid->cells[x][y][z].staticObjects)
+					{
+						potentialCollisionObjects.insert(potentialStaticObject);
+					}
+					for (auto & potentialObject : grid->cells[x][y][z].objects)
+					{
+						if (potentialObject != object)
+						{
+							potentialCollisionObjects.insert(potentialObject);
+						}
+					}
+					grid->insertObject(object, glm::uvec3(x, y, z));
+				}
+
+		for (auto & potentialObject : potentialCollisionObjects)
+		{
+			if (checkCollisionAABBs(object->aabb, potentialObject->aabb))
+				pairs.push_back({ object, potentialObject });
+		}
+	}
+}
+
+const char* GridBroadPhase::getName()
+{
+	return "uniform grid";
+}
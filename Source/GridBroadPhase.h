@@ -0,0 +1,50 @@
+/**
+ * Bakalarska praca - Simualace pevnych teles
+ * VUT FIT, 2018/2019
+ *
+ * Autor:	Denis Leitner, xleitn02
+ * Subor:	GridBroadPhase.h
+ *
+ */
+
+#pragma once
+
+#ifndef GRID_BROAD_PHASE_H
+#define GRID_BROAD_PHASE_H
+
+#include "BroadPhase.h"
+
+/**
+ * @brief Broad phase using uniform grid, objects are inserted into all cells they occupy
+ */
+class GridBroadPhase : public BroadPhase
+{
+public:
+	// NULL if memory for grid couldn't be allocated
+	Grid* grid;
+
+	/**
+	 * @brief Creates uniform grid
+	 * @param settings Parameters of the grid
+	 */
+	GridBroadPhase(const BroadPhaseSettings& settings);
+	~GridBroadPhase();
+
+	/**
+	 * @brief Inserts static object into grid, part of the object out of grid is left out
+	 */
+	bool insertStaticObject(Object* object) override;
+	void update(const std::vector<Object*>& objects) override;
+
+	/**
+	 * @brief Inserts dynamic objects into grid one by one, each object is paired
+	 *        with objects already present in cells it occupies
+	 */
+	void findPairs(std::vector<ObjectPair>& pairs) override;
+	const char* getName() override;
+
+private:
+	std::vector<Object*> dynamicObjects;
+};
+
+#endif
@@ -0,0 +1,73 @@
+/**
+ * Bakalarska praca - Simualace pevnych teles
+ * VUT FIT, 2018/2019
+ *
+ * Autor:	Denis Leitner, xleitn02
+ * Subor:	HalfSpace.cpp
+ *
+ */
+
+#include "HalfSpace.h"
+#include <cmath>
+
+
+HalfSpace::HalfSpace()
+{
+	type = halfSpace;
+	normal = glm::vec3(0.0f, 1.0f, 0.0f);
+	offset = 0.0f;
+	bounded = false;
+	boundsMin = glm::vec3(0.0f);
+	boundsMax = glm::vec3(0.0f);
+}
+
+bool HalfSpace::setBoundary(const std::vector<glm::vec3>& vertices, const glm::vec3& normal, bool bounded)
+{
+	if (vertices.empty())
+		return false;
+
+	this->normal = glm::normalize(normal);
+	this->offset = glm::dot(this->normal, vertices[0]);
+	this->bounded = bounded;
+
+	boundsMin = vertices[0];
+	boundsMax = vertices[0];
+
+	for (auto & vertex : vertices)
+	{
+		// model of curved or thick shape can't be replaced by its plane
+		if (std::abs(glm::dot(this->normal, vertex) - this->offset) > HALF_SPACE_FLATNESS_TOLERANCE)
+			return false;
+
+		boundsMin = glm::min(boundsMin, vertex);
+		boundsMax = glm::max(boundsMax, vertex);
+	}
+
+	return true;
+}
+
+bool HalfSpace::isWithinBounds(const glm::vec3& point, float margin) const
+{
+	if (!bounded)
+		return true;
+
+	// bounds are flat in direction of normal, point is compared after projection onto boundary plane
+	glm::vec3 projection = point - normal * (glm::dot(normal, point) - offset);
+
+	for (int i = 0; i < 3; i++)
+	{
+		if (projection[i] < boundsMin[i] - margin - EPSILON || projection[i] > boundsMax[i] + margin + EPSILON)
+			return false;
+	}
+
+	return true;
+}
+
+void HalfSpace::calculateAttributes(Object* object)
+{
+	// half-space can't move, it behaves as an object with infinite density
+	object->centerOfMass = glm::vec3(0.0f);
+	object->mass = INFINITY;
+	object->inverseMass = 0.0f;
+	object->inverseBodyInertiaTensor = glm::mat3(0.0f);
+}
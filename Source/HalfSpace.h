@@ -0,0 +1,59 @@
+/**
+ * Bakalarska praca - Simualace pevnych teles
+ * VUT FIT, 2018/2019
+ *
+ * Autor:	Denis Leitner, xleitn02
+ * Subor:	HalfSpace.h
+ *
+ */
+
+#pragma once
+
+#ifndef HALF_SPACE_H
+#define HALF_SPACE_H
+
+#include <glm/glm.hpp>
+#include <vector>
+
+#include "Shape.h"
+#include "Object.h"
+
+// largest distance of vertex of half-space model from its boundary plane
+constexpr float HALF_SPACE_FLATNESS_TOLERANCE = 0.001f;
+
+/**
+ * @brief Solid half-space below a plane, used for static ground and walls; its model is used only for rendering
+ */
+class HalfSpace : public Shape
+{
+public:
+	glm::vec3 normal;		// outer normal of boundary plane in local space
+	float offset;			// dot product of normal and any point of boundary plane
+	// whether half-space is limited to bounds of its model in boundary plane
+	bool bounded;
+	glm::vec3 boundsMin;
+	glm::vec3 boundsMax;
+
+	HalfSpace();
+
+	/**
+	 * @brief Sets boundary plane from vertices of model, which have to lie in the plane
+	 * @param vertices Vertices of model in local space
+	 * @param normal Outer normal of the plane
+	 * @param bounded Whether half-space is limited to bounds of vertices
+	 * @return Whether plane could be set, false if there are no vertices or they don't lie in one plane
+	 */
+	bool setBoundary(const std::vector<glm::vec3>& vertices, const glm::vec3& normal, bool bounded);
+
+	/**
+	 * @brief Checks whether point lies within bounds of half-space when projected onto boundary plane
+	 * @param point Point in local space
+	 * @param margin Distance by which bounds are enlarged, radius of sphere whose centre is tested
+	 * @return Whether point is within bounds, always true for unbounded half-space
+	 */
+	bool isWithinBounds(const glm::vec3& point, float margin = 0.0f) const;
+
+	void calculateAttributes(Object* object) override;
+};
+
+#endif
@@ -0,0 +1,146 @@
+/**
+ * Bakalarska praca - Simualace pevnych teles
+ * VUT FIT, 2018/2019
+ *
+ * Autor:	Denis Leitner, xleitn02
+ * Subor:	HierarchicalGrid.cpp
+ *
+ */
+
+#include "HierarchicalGrid.h"
+#include <algorithm>
+
+
+HierarchicalGrid::HierarchicalGrid(float cellSize, glm::uvec3 size, glm::vec3 origin, unsigned levelCount)
+{
+	for (unsigned i = 0; i < levelCount; i++)
+	{
+		Grid* level = new Grid(cellSize, size, origin);
+		if (level->cells == NULL)
+		{
+			// memory for grid cells couldn't be allocated
+			delete level;
+			for (auto & grid : levels)
+				delete grid;
+			levels.clear();
+			return;
+		}
+		levels.push_back(level);
+
+		// every level covers the same region with cells of double size
+		cellSize *= 2.0f;
+		size = (size + glm::uvec3(1)) / 2u;
+	}
+}
+
+
+HierarchicalGrid::~HierarchicalGrid()
+{
+	for (auto & level : levels)
+		delete level;
+}
+
+unsigned HierarchicalGrid::getLevel(AABB* aabb)
+{
+	glm::vec3 extent = aabb->max - aabb->min;
+	float maxExtent = std::max(extent.x, std::max(extent.y, extent.z));
+
+	unsigned level = 0;
+	while (level < levels.size() - 1 && levels[level]->cellSize < maxExtent)
+		level++;
+
+	return level;
+}
+
+bool HierarchicalGrid::insertObject(Object* object)
+{
+	Grid* grid = levels[getLevel(object->aabb)];
+	glm::uvec3 minIndices;
+	glm::uvec3 maxIndices;
+
+	if (!grid->mapAABBToIndices(object->aabb, minIndices, maxIndices))
+	{
+		// can't be inserted into grid
+		return false;
+	}
+
+	for (unsigned x = minIndices.x; x <= maxIndices.x; x++)
+		for (unsigned y = minIndices.y; y <= maxIndices.y; y++)
+			for (unsigned z = minIndices.z; z <= maxIndices.z; z++)
+			{
+				grid->insertObject(object, glm::uvec3(x, y, z));
+			}
+
+	return true;
+}
+
+bool HierarchicalGrid::insertStaticObject(Object* object)
+{
+	for (unsigned level = getLevel(object->aabb); level < levels.size(); level++)
+	{
+		Grid* grid = levels[level];
+		glm::uvec3 minIndices;
+		glm::uvec3 maxIndices;
+
+		if (!grid->clampAABBToIndices(object->aabb, minIndices, maxIndices))
+		{
+			// object is completely out of grid
+			return false;
+		}
+
+		for (unsigned x = minIndices.x; x <= maxIndices.x; x++)
+			for (unsigned y = minIndices.y; y <= maxIndices.y; y++)
+				for (unsigned z = minIndices.z; z <= maxIndices.z; z++)
+				{
+					grid->insertStaticObject(object, glm::uvec3(x, y, z));
+				}
+	}
+
+	return true;
+}
+
+bool HierarchicalGrid::findPotentialCollisions(Object* object, std::unordered_set<Object*>& potentialCollisionObjects)
+{
+	unsigned objectLevel = getLevel(object->aabb);
+
+	// walk levels from the coarsest to the level of the object
+	for (int level = levels.size() - 1; level >= (int)objectLevel; level--)
+	{
+		Grid* grid = levels[level];
+		glm::uvec3 minIndices;
+		glm::uvec3 maxIndices;
+
+		if (!grid->mapAABBToIndices(object->aabb, minIndices, maxIndices))
+		{
+			// object is out of grid
+			return false;
+		}
+
+		for (unsigned x = minIndices.x; x <= maxIndices.x; x++)
+			for (unsigned y = minIndices.y; y <= maxIndices.y; y++)
+				for (unsigned z = minIndices.z; z <= maxIndices.z; z++)
+				{
+					Cell& cell = grid->cells[x][y][z];
+
+					for (auto & potentialStaticObject : cell.staticObjects)
+					{
+						potentialCollisionObjects.insert(potentialStaticObject);
+					}
+					for (auto & potentialObject : cell.objects)
+					{
+						if (potentialObject != object)
+						{
+							potentialCollisionObjects.insert(potentialObject);
+						}
+					}
+				}
+	}
+
+	return true;
+}
+
+void HierarchicalGrid::clearGrid()
+{
+	for (auto & level : levels)
+		level->clearGrid();
+}
@@ -0,0 +1,78 @@
+/**
+ * Bakalarska praca - Simualace pevnych teles
+ * VUT FIT, 2018/2019
+ *
+ * Autor:	Denis Leitner, xleitn02
+ * Subor:	HierarchicalGrid.h
+ *
+ */
+
+#pragma once
+
+#ifndef HIERARCHICAL_GRID_H
+#define HIERARCHICAL_GRID_H
+
+#include "Grid.h"
+
+#define HGRID_LEVELS 5		// default number of levels, cell size of level i is CELL_SIZE * 2^i
+#define HGRID_MAX_LEVELS 8
+
+/**
+ * @brief Class representing hierarchy of uniform grids covering the same region, every object is stored
+ *        in the level whose cell size matches the object's size, so it occupies at most 2 cells along each axis
+ */
+class HierarchicalGrid
+{
+public:
+	// grid levels from the finest to the coarsest
+	std::vector<Grid*> levels;
+
+	/**
+	 * @brief Creates all levels of grid, levels vector is left empty if memory could not be allocated
+	 * @param cellSize Edge length of one cell of the finest level
+	 * @param size Number of cells of the finest level in format x: height, y: width, z: depth
+	 * @param origin World-space coordinates of the minimal corner of the grid
+	 * @param levelCount Number of levels
+	 */
+	HierarchicalGrid(float cellSize = CELL_SIZE, glm::uvec3 size = glm::uvec3(GRID_HEIGHT, GRID_WIDTH, GRID_DEPTH),
+		glm::vec3 origin = glm::vec3(MIN_WIDTH_COORD, MIN_HEIGHT_COORD, MIN_DEPTH_COORD), unsigned levelCount = HGRID_LEVELS);
+	~HierarchicalGrid();
+
+	/**
+	 * @brief Finds grid level whose cell size matches the size of given AABB
+	 * @param aabb AABB for which to find level
+	 * @return Index of the level
+	 */
+	unsigned getLevel(AABB* aabb);
+
+	/**
+	 * @brief Inserts dynamic object into cells of its level
+	 * @param object Object to be inserted
+	 * @return Whether object was inserted
+	 */
+	bool insertObject(Object* object);
+
+	/**
+	 * @brief Inserts static object into cells of its level and of all coarser levels,
+	 *        so it can be found by objects of any level; part of the object out of grid is left out
+	 * @param object Object to be inserted
+	 * @return Whether object was inserted
+	 */
+	bool insertStaticObject(Object* object);
+
+	/**
+	 * @brief Finds objects sharing cells with given object, walks the levels from the coarsest one
+	 *        to the level of the object; objects in finer levels find this object by themselves
+	 * @param object Object for which to find potential collision partners
+	 * @param[out] potentialCollisionObjects Found objects
+	 * @return Whether object could be mapped to the grid
+	 */
+	bool findPotentialCollisions(Object* object, std::unordered_set<Object*>& potentialCollisionObjects);
+
+	/**
+	 * @brief Removes all dynamic objects from all levels
+	 */
+	void clearGrid();
+};
+
+#endif
@@ -0,0 +1,69 @@
+/**
+ * Bakalarska praca - Simualace pevnych teles
+ * VUT FIT, 2018/2019
+ *
+ * Autor:	Denis Leitner, xleitn02
+ * Subor:	HierarchicalGridBroadPhase.cpp
+ *
+ */
+
+#include "HierarchicalGridBroadPhase.h"
+#include <algorithm>
+
+
+HierarchicalGridBroadPhase::HierarchicalGridBroadPhase(const BroadPhaseSettings& settings)
+{
+	grid = new HierarchicalGrid(settings.cellSize, settings.gridSize, settings.gridOrigin, settings.levels);
+}
+
+HierarchicalGridBroadPhase::~HierarchicalGridBroadPhase()
+{
+	delete grid;
+}
+
+bool HierarchicalGridBroadPhase::insertStaticObject(Object* object)
+{
+	return grid->insertStaticObject(object);
+}
+
+void HierarchicalGridBroadPhase::update(const std::vector<Object*>& objects)
+{
+	grid->clearGrid();
+	dynamicObjects = objects;
+	rejectedObjects = 0;
+
+	// objects in coarser levels first
+	std::stable_sort(dynamicObjects.begin(), dynamicObjects.end(), [this](Object* object0, Object* object1)
+	{
+		return grid->getLevel(object0->aabb) > grid->getLevel(object1->aabb);
+	});
+}
+
+void HierarchicalGridBroadPhase::findPairs(std::vector<ObjectPair>& pairs)
+{
+	std::unordered_set<Object*> potentialCollisionObjects;
+
+	for (auto & object : dynamicObjects)
+	{
+		if (!grid->insertObject(object))
+		{
+			// can't be inserted into grid
+			rejectedObjects++;
+			continue;
+		}
+
+		potentialCollisionObjects.clear();
+		grid->findPotentialCollisions(object, potentialCollisionObjects);
+
+		for (auto & potentialObject : potentialCollisionObjects)
+		{
+			if (checkCollisionAABBs(object->aabb, potentialObject->aabb))
+				pairs.push_back({ object, potentialObject });
+		}
+	}
+}
+
+const char* HierarchicalGridBroadPhase::getName()
+{
+	return "hierarchical grid";
+}
@@ -0,0 +1,46 @@
+/**
+ * Bakalarska praca - Simualace pevnych teles
+ * VUT FIT, 2018/2019
+ *
+ * Autor:	Denis Leitner, xleitn02
+ * Subor:	HierarchicalGridBroadPhase.h
+ *
+ */
+
+#pragma once
+
+#ifndef HIERARCHICAL_GRID_BROAD_PHASE_H
+#define HIERARCHICAL_GRID_BROAD_PHASE_H
+
+#include "BroadPhase.h"
+
+/**
+ * @brief Broad phase using hierarchical grid, suitable for objects of very different sizes
+ */
+class HierarchicalGridBroadPhase : public BroadPhase
+{
+public:
+	HierarchicalGrid* grid;
+
+	/**
+	 * @brief Creates hierarchical grid, its levels are empty if memory couldn't be allocated
+	 * @param settings Parameters of the finest level and number of levels
+	 */
+	HierarchicalGridBroadPhase(const BroadPhaseSettings& settings);
+	~HierarchicalGridBroadPhase();
+
+	bool insertStaticObject(Object* object) override;
+
+	/**
+	 * @brief Orders dynamic objects so that objects in coarser levels are inserted
+	 *        before objects in finer levels
+	 */
+	void update(const std::vector<Object*>& objects) override;
+	void findPairs(std::vector<ObjectPair>& pairs) override;
+	const char* getName() override;
+
+private:
+	std::vector<Object*> dynamicObjects;
+};
+
+#endif
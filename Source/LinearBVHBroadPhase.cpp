@@ -0,0 +1,480 @@
+/**
+ * Bakalarska praca - Simualace pevnych teles
+ * VUT FIT, 2018/2019
+ *
+ * Autor:	Denis Leitner, xleitn02
+ * Subor:	LinearBVHBroadPhase.cpp
+ *
+ */
+
+#include "LinearBVHBroadPhase.h"
+#include <algorithm>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+// parent of the root
+#define LBVH_NO_PARENT 0xFFFFFFFFu
+
+/**
+ * @brief Counts leading zero bits of non-zero value
+ */
+static int countLeadingZeros(unsigned value)
+{
+#ifdef _MSC_VER
+	unsigned long index;
+	_BitScanReverse(&index, value);
+	return 31 - (int)index;
+#else
+	return __builtin_clz(value);
+#endif
+}
+
+/**
+ * @brief Checks whether 2 boxes given by their corners overlap
+ */
+static bool overlaps(const glm::vec3& min0, const glm::vec3& max0, const glm::vec3& min1, const glm::vec3& max1)
+{
+	return !(max0.x < min1.x || min0.x > max1.x || max0.y < min1.y || min0.y > max1.y || max0.z < min1.z || min0.z > max1.z);
+}
+
+unsigned expandBits(unsigned value)
+{
+	value = (value * 0x00010001u) & 0xFF0000FFu;
+	value = (value * 0x00000101u) & 0x0F00F00Fu;
+	value = (value * 0x00000011u) & 0xC30C30C3u;
+	value = (value * 0x00000005u) & 0x49249249u;
+	return value;
+}
+
+unsigned mortonCode(const glm::vec3& point)
+{
+	const float cells = (float)(1 << MORTON_AXIS_BITS);
+	glm::vec3 scaled = glm::clamp(point * cells, glm::vec3(0.0f), glm::vec3(cells - 1.0f));
+
+	unsigned x = expandBits((unsigned)scaled.x);
+	unsigned y = expandBits((unsigned)scaled.y);
+	unsigned z = expandBits((unsigned)scaled.z);
+
+	return (x << 2) | (y << 1) | z;
+}
+
+LinearBVHBroadPhase::LinearBVHBroadPhase(const BroadPhaseSettings& settings, ThreadPool* threadPool)
+{
+	this->threadPool = threadPool;
+	margin = settings.treeMargin;
+	visits = NULL;
+	built = false;
+}
+
+LinearBVHBroadPhase::~LinearBVHBroadPhase()
+{
+	if (visits != NULL)
+		delete[] visits;
+}
+
+bool LinearBVHBroadPhase::insertStaticObject(Object* object)
+{
+	staticObjects.push_back(object);
+	built = false;
+	return true;
+}
+
+void LinearBVHBroadPhase::update(const std::vector<Object*>& objects)
+{
+	if (!isTreeValid(objects))
+	{
+		dynamicObjects = objects;
+		build();
+	}
+
+	copyObjectBounds();
+}
+
+void LinearBVHBroadPhase::findPairs(std::vector<ObjectPair>& pairs)
+{
+	unsigned threadCount = threadPool != NULL ? threadPool->getThreadCount() : 1;
+	threadPairs.resize(threadCount);
+
+	// leaves are queried in Morton order, so consecutive queries visit the same nodes
+	parallelFor(leafObjects.size(), [this](unsigned begin, unsigned end, unsigned thread)
+	{
+		std::vector<ObjectPair>& found = threadPairs[thread];
+		found.clear();
+
+		for (unsigned leaf = begin; leaf < end; leaf++)
+		{
+			if (!leafStatic[leaf])
+				traverse(leaf, found);
+		}
+	});
+
+	// pairs of thread 0 first, so the order doesn't depend on timing of threads
+	for (auto & found : threadPairs)
+	{
+		pairs.insert(pairs.end(), found.begin(), found.end());
+	}
+}
+
+const char* LinearBVHBroadPhase::getName()
+{
+	return "linear BVH";
+}
+
+void LinearBVHBroadPhase::parallelFor(unsigned count, const ThreadPool::Task& task)
+{
+	if (threadPool != NULL)
+		threadPool->parallelFor(count, task);
+	else
+		task(0, count, 0);
+}
+
+bool LinearBVHBroadPhase::isTreeValid(const std::vector<Object*>& objects)
+{
+	if (!built || objects.size() != dynamicObjects.size())
+		return false;
+
+	for (unsigned i = 0; i < objects.size(); i++)
+	{
+		if (objects[i] != dynamicObjects[i])
+			return false;
+
+		// object has to stay inside enlarged AABB of its leaf
+		unsigned leaf = dynamicLeaves[i];
+		AABB* aabb = objects[i]->aabb;
+		if (glm::any(glm::lessThan(aabb->min, leafMin[leaf])) || glm::any(glm::greaterThan(aabb->max, leafMax[leaf])))
+			return false;
+	}
+
+	return true;
+}
+
+void LinearBVHBroadPhase::copyObjectBounds()
+{
+	objectMin.resize(leafObjects.size());
+	objectMax.resize(leafObjects.size());
+
+	parallelFor(leafObjects.size(), [this](unsigned begin, unsigned end, unsigned /*thread*/)
+	{
+		for (unsigned leaf = begin; leaf < end; leaf++)
+		{
+			objectMin[leaf] = leafObjects[leaf]->aabb->min;
+			objectMax[leaf] = leafObjects[leaf]->aabb->max;
+		}
+	});
+}
+
+void LinearBVHBroadPhase::build()
+{
+	unsigned dynamicCount = dynamicObjects.size();
+	unsigned leafCount = dynamicCount + staticObjects.size();
+	unsigned threadCount = threadPool != NULL ? threadPool->getThreadCount() : 1;
+
+	// objects are indexed as dynamic objects followed by static objects
+	auto getObject = [this, dynamicCount](unsigned index)
+	{
+		return index < dynamicCount ? dynamicObjects[index] : staticObjects[index - dynamicCount];
+	};
+
+	built = true;
+	leafObjects.resize(leafCount);
+	leafMin.resize(leafCount);
+	leafMax.resize(leafCount);
+	leafStatic.resize(leafCount);
+	dynamicLeaves.resize(dynamicCount);
+	codes.resize(leafCount);
+	indices.resize(leafCount);
+	codesTemp.resize(leafCount);
+	indicesTemp.resize(leafCount);
+	nodes.resize(leafCount > 0 ? leafCount - 1 : 0);
+	nodeParents.resize(nodes.size());
+	leafParents.assign(leafCount, LBVH_NO_PARENT);
+
+	if (leafCount == 0)
+		return;
+
+	// bounds of AABB centres
+	std::vector<glm::vec3> threadMin(threadCount, glm::vec3(FLT_MAX));
+	std::vector<glm::vec3> threadMax(threadCount, glm::vec3(-FLT_MAX));
+
+	parallelFor(leafCount, [&](unsigned begin, unsigned end, unsigned thread)
+	{
+		for (unsigned i = begin; i < end; i++)
+		{
+			AABB* aabb = getObject(i)->aabb;
+			glm::vec3 centre = 0.5f * (aabb->min + aabb->max);
+			threadMin[thread] = glm::min(threadMin[thread], centre);
+			threadMax[thread] = glm::max(threadMax[thread], centre);
+		}
+	});
+
+	glm::vec3 boundsMin = threadMin[0];
+	glm::vec3 boundsMax = threadMax[0];
+	for (unsigned thread = 1; thread < threadCount; thread++)
+	{
+		boundsMin = glm::min(boundsMin, threadMin[thread]);
+		boundsMax = glm::max(boundsMax, threadMax[thread]);
+	}
+	glm::vec3 inverseExtent = 1.0f / glm::max(boundsMax - boundsMin, glm::vec3(EPSILON));
+
+	parallelFor(leafCount, [&](unsigned begin, unsigned end, unsigned /*thread*/)
+	{
+		for (unsigned i = begin; i < end; i++)
+		{
+			AABB* aabb = getObject(i)->aabb;
+			glm::vec3 centre = 0.5f * (aabb->min + aabb->max);
+			codes[i] = mortonCode((centre - boundsMin) * inverseExtent);
+			indices[i] = i;
+		}
+	});
+
+	sortCodes();
+
+	// leaves in sorted order
+	parallelFor(leafCount, [&](unsigned begin, unsigned end, unsigned /*thread*/)
+	{
+		for (unsigned leaf = begin; leaf < end; leaf++)
+		{
+			unsigned index = indices[leaf];
+			Object* object = getObject(index);
+			bool isStatic = index >= dynamicCount;
+
+			// static objects don't move, their AABBs don't need margin
+			glm::vec3 leafMargin = glm::vec3(isStatic ? 0.0f : margin);
+
+			leafObjects[leaf] = object;
+			leafMin[leaf] = object->aabb->min - leafMargin;
+			leafMax[leaf] = object->aabb->max + leafMargin;
+
+			if (!isStatic)
+				dynamicLeaves[index] = leaf;
+		}
+	});
+
+	// vector<bool> can't be written from more threads
+	for (unsigned leaf = 0; leaf < leafCount; leaf++)
+	{
+		leafStatic[leaf] = indices[leaf] >= dynamicCount;
+	}
+
+	if (nodes.empty())
+		return;
+
+	nodeParents[0] = LBVH_NO_PARENT;
+
+	parallelFor(nodes.size(), [this](unsigned begin, unsigned end, unsigned /*thread*/)
+	{
+		for (unsigned node = begin; node < end; node++)
+		{
+			buildNode(node);
+		}
+	});
+
+	if (visits != NULL)
+		delete[] visits;
+	visits = new std::atomic<unsigned>[nodes.size()];
+	for (unsigned node = 0; node < nodes.size(); node++)
+	{
+		visits[node] = 0;
+	}
+
+	parallelFor(leafCount, [this](unsigned begin, unsigned end, unsigned /*thread*/)
+	{
+		for (unsigned leaf = begin; leaf < end; leaf++)
+		{
+			computeBounds(leaf);
+		}
+	});
+}
+
+void LinearBVHBroadPhase::sortCodes()
+{
+	const unsigned bucketCount = 1 << RADIX_BITS;
+	const unsigned mask = bucketCount - 1;
+	unsigned count = codes.size();
+	unsigned threadCount = threadPool != NULL ? threadPool->getThreadCount() : 1;
+
+	histograms.resize(threadCount * bucketCount);
+
+	for (unsigned shift = 0; shift < 3 * MORTON_AXIS_BITS; shift += RADIX_BITS)
+	{
+		// count digits in part of every thread
+		parallelFor(count, [&](unsigned begin, unsigned end, unsigned thread)
+		{
+			unsigned* histogram = &histograms[thread * bucketCount];
+			std::fill(histogram, histogram + bucketCount, 0);
+
+			for (unsigned i = begin; i < end; i++)
+			{
+				histogram[(codes[i] >> shift) & mask]++;
+			}
+		});
+
+		// first position of every digit in part of every thread, parts are kept in order so sort is stable
+		unsigned position = 0;
+		for (unsigned digit = 0; digit < bucketCount; digit++)
+			for (unsigned thread = 0; thread < threadCount; thread++)
+			{
+				unsigned digitCount = histograms[thread * bucketCount + digit];
+				histograms[thread * bucketCount + digit] = position;
+				position += digitCount;
+			}
+
+		parallelFor(count, [&](unsigned begin, unsigned end, unsigned thread)
+		{
+			unsigned* histogram = &histograms[thread * bucketCount];
+
+			for (unsigned i = begin; i < end; i++)
+			{
+				unsigned target = histogram[(codes[i] >> shift) & mask]++;
+				codesTemp[target] = codes[i];
+				indicesTemp[target] = indices[i];
+			}
+		});
+
+		codes.swap(codesTemp);
+		indices.swap(indicesTemp);
+	}
+}
+
+int LinearBVHBroadPhase::commonPrefix(int i, int j)
+{
+	if (j < 0 || j >= (int)codes.size())
+		return -1;
+
+	if (codes[i] == codes[j])
+	{
+		// equal codes are distinguished by leaf indices
+		return 32 + countLeadingZeros((unsigned)(i ^ j));
+	}
+
+	return countLeadingZeros(codes[i] ^ codes[j]);
+}
+
+void LinearBVHBroadPhase::buildNode(unsigned node)
+{
+	int i = node;
+
+	// direction of the range of leaves covered by node
+	int direction = commonPrefix(i, i + 1) > commonPrefix(i, i - 1) ? 1 : -1;
+	int minPrefix = commonPrefix(i, i - direction);
+
+	// upper bound of the length of the range
+	int maxLength = 2;
+	while (commonPrefix(i, i + maxLength * direction) > minPrefix)
+		maxLength *= 2;
+
+	// other end of the range by binary search
+	int length = 0;
+	for (int step = maxLength / 2; step >= 1; step /= 2)
+	{
+		if (commonPrefix(i, i + (length + step) * direction) > minPrefix)
+			length += step;
+	}
+	int j = i + length * direction;
+
+	// split position where common prefix of the range ends, by binary search
+	int nodePrefix = commonPrefix(i, j);
+	int split = 0;
+	int step = length;
+	do
+	{
+		step = (step + 1) / 2;
+		if (commonPrefix(i, i + (split + step) * direction) > nodePrefix)
+			split += step;
+	} while (step > 1);
+	int splitPosition = i + split * direction + std::min(direction, 0);
+
+	LBVHNode& current = nodes[node];
+
+	if (std::min(i, j) == splitPosition)
+	{
+		current.children[0] = splitPosition | LBVH_LEAF_FLAG;
+		leafParents[splitPosition] = node;
+	}
+	else
+	{
+		current.children[0] = splitPosition;
+		nodeParents[splitPosition] = node;
+	}
+
+	if (std::max(i, j) == splitPosition + 1)
+	{
+		current.children[1] = (splitPosition + 1) | LBVH_LEAF_FLAG;
+		leafParents[splitPosition + 1] = node;
+	}
+	else
+	{
+		current.children[1] = splitPosition + 1;
+		nodeParents[splitPosition + 1] = node;
+	}
+}
+
+void LinearBVHBroadPhase::computeBounds(unsigned leaf)
+{
+	unsigned node = leafParents[leaf];
+
+	while (node != LBVH_NO_PARENT)
+	{
+		// first thread to reach node leaves it for the second one, which has both children ready
+		if (visits[node].fetch_add(1) == 0)
+			return;
+
+		LBVHNode& current = nodes[node];
+		current.min = glm::vec3(FLT_MAX);
+		current.max = glm::vec3(-FLT_MAX);
+
+		for (unsigned child : current.children)
+		{
+			if (child & LBVH_LEAF_FLAG)
+			{
+				current.min = glm::min(current.min, leafMin[child & ~LBVH_LEAF_FLAG]);
+				current.max = glm::max(current.max, leafMax[child & ~LBVH_LEAF_FLAG]);
+			}
+			else
+			{
+				current.min = glm::min(current.min, nodes[child].min);
+				current.max = glm::max(current.max, nodes[child].max);
+			}
+		}
+
+		node = nodeParents[node];
+	}
+}
+
+void LinearBVHBroadPhase::traverse(unsigned leaf, std::vector<ObjectPair>& pairs)
+{
+	if (nodes.empty())
+		return;
+
+	const glm::vec3& min = objectMin[leaf];
+	const glm::vec3& max = objectMax[leaf];
+
+	unsigned stack[LBVH_STACK_SIZE];
+	unsigned stackSize = 0;
+	stack[stackSize++] = 0;
+
+	while (stackSize > 0)
+	{
+		LBVHNode& node = nodes[stack[--stackSize]];
+
+		for (unsigned child : node.children)
+		{
+			if (child & LBVH_LEAF_FLAG)
+			{
+				unsigned otherLeaf = child & ~LBVH_LEAF_FLAG;
+
+				// pair of dynamic objects is reported by the one with lower leaf index
+				if (otherLeaf == leaf || (!leafStatic[otherLeaf] && otherLeaf < leaf))
+					continue;
+
+				if (overlaps(min, max, objectMin[otherLeaf], objectMax[otherLeaf]))
+					pairs.push_back({ leafObjects[leaf], leafObjects[otherLeaf] });
+			}
+			else if (overlaps(min, max, nodes[child].min, nodes[child].max))
+			{
+				stack[stackSize++] = child;
+			}
+		}
+	}
+}
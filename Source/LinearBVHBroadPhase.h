@@ -0,0 +1,166 @@
+/**
+ * Bakalarska praca - Simualace pevnych teles
+ * VUT FIT, 2018/2019
+ *
+ * Autor:	Denis Leitner, xleitn02
+ * Subor:	LinearBVHBroadPhase.h
+ *
+ */
+
+#pragma once
+
+#ifndef LINEAR_BVH_BROAD_PHASE_H
+#define LINEAR_BVH_BROAD_PHASE_H
+
+#include <atomic>
+#include "BroadPhase.h"
+#include "ThreadPool.h"
+
+#define MORTON_AXIS_BITS 10			// bits per axis of Morton code, code has 3 times more
+#define RADIX_BITS 10				// bits sorted by one pass of radix sort
+#define LBVH_LEAF_FLAG 0x80000000u	// marks child index that points to a leaf
+#define LBVH_STACK_SIZE 96			// capacity of traversal stack, tree is at most 64 levels deep
+
+/**
+ * @brief Internal node of linear BVH
+ */
+struct LBVHNode
+{
+	glm::vec3 min;
+	glm::vec3 max;
+	// indices of internal nodes or leaves marked with LBVH_LEAF_FLAG
+	unsigned children[2];
+};
+
+/**
+ * @brief Broad phase for large number of objects; objects are sorted by Morton codes of their AABB centres
+ *        and linear BVH is built over the sorted order, tree is traversed for every dynamic object in parallel.
+ *        Leaves hold AABBs enlarged by margin, tree is rebuilt only when some object leaves its enlarged AABB.
+ */
+class LinearBVHBroadPhase : public BroadPhase
+{
+public:
+	/**
+	 * @brief Creates empty tree
+	 * @param settings Settings with margin of leaf AABBs
+	 * @param threadPool Threads for build and traversal, NULL for single-threaded run
+	 */
+	LinearBVHBroadPhase(const BroadPhaseSettings& settings, ThreadPool* threadPool);
+	~LinearBVHBroadPhase();
+
+	bool insertStaticObject(Object* object) override;
+
+	/**
+	 * @brief Rebuilds tree if set of objects changed or some object left AABB of its leaf
+	 */
+	void update(const std::vector<Object*>& objects) override;
+	void findPairs(std::vector<ObjectPair>& pairs) override;
+	const char* getName() override;
+
+private:
+	ThreadPool* threadPool;
+	float margin;
+
+	std::vector<Object*> staticObjects;
+	std::vector<Object*> dynamicObjects;
+
+	// leaves in Morton order: object, enlarged AABB and whether object is static
+	std::vector<Object*> leafObjects;
+	std::vector<glm::vec3> leafMin;
+	std::vector<glm::vec3> leafMax;
+	std::vector<bool> leafStatic;
+	// current AABBs of leaf objects, copied so that traversal doesn't touch objects
+	std::vector<glm::vec3> objectMin;
+	std::vector<glm::vec3> objectMax;
+	// leaf of every dynamic object, indexed as dynamicObjects
+	std::vector<unsigned> dynamicLeaves;
+
+	// internal nodes, root is node 0
+	std::vector<LBVHNode> nodes;
+	// parents of internal nodes and leaves
+	std::vector<unsigned> nodeParents;
+	std::vector<unsigned> leafParents;
+	// number of children that reached internal node during bottom-up computation of AABBs
+	std::atomic<unsigned>* visits;
+
+	// Morton codes and object indices, sorted and temporary buffers
+	std::vector<unsigned> codes;
+	std::vector<unsigned> indices;
+	std::vector<unsigned> codesTemp;
+	std::vector<unsigned> indicesTemp;
+	// per-thread histograms of radix sort
+	std::vector<unsigned> histograms;
+	// per-thread found pairs
+	std::vector<std::vector<ObjectPair>> threadPairs;
+
+	bool built;
+
+	/**
+	 * @brief Runs task over range on thread pool or on calling thread if there is no thread pool
+	 */
+	void parallelFor(unsigned count, const ThreadPool::Task& task);
+
+	/**
+	 * @brief Checks whether tree can be kept for given objects
+	 */
+	bool isTreeValid(const std::vector<Object*>& objects);
+
+	/**
+	 * @brief Copies current AABBs of objects to leaf order
+	 */
+	void copyObjectBounds();
+
+	/**
+	 * @brief Computes Morton codes, sorts leaves, builds hierarchy and computes AABBs of internal nodes
+	 */
+	void build();
+
+	/**
+	 * @brief Sorts codes together with indices by parallel LSD radix sort
+	 */
+	void sortCodes();
+
+	/**
+	 * @brief Creates internal node, finds range of leaves it covers and splits it between its children
+	 * @param node Index of internal node
+	 */
+	void buildNode(unsigned node);
+
+	/**
+	 * @brief Length of the common prefix of codes of 2 leaves, leaf index breaks ties of equal codes
+	 * @param i Index of the first leaf
+	 * @param j Index of the second leaf, may be out of range
+	 * @return Length of common prefix, -1 if j is out of range
+	 */
+	int commonPrefix(int i, int j);
+
+	/**
+	 * @brief Computes AABBs of internal nodes on the path from leaf to root, node is computed
+	 *        by the thread that reaches it as the second one
+	 * @param leaf Index of the leaf
+	 */
+	void computeBounds(unsigned leaf);
+
+	/**
+	 * @brief Finds leaves overlapping leaf of dynamic object, each pair is reported only once
+	 * @param leaf Leaf of dynamic object
+	 * @param[out] pairs Found pairs are appended here
+	 */
+	void traverse(unsigned leaf, std::vector<ObjectPair>& pairs);
+};
+
+/**
+ * @brief Spreads lower 10 bits of value so that there are 2 zero bits between every 2 bits
+ * @param value Value to spread
+ * @return Spread bits
+ */
+unsigned expandBits(unsigned value);
+
+/**
+ * @brief Computes 30-bit Morton code of point in unit cube
+ * @param point Point with coordinates in range [0, 1]
+ * @return Morton code
+ */
+unsigned mortonCode(const glm::vec3& point);
+
+#endif
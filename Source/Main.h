@@ -1,21 +1,21 @@
-/**
- * Bakalarska praca - Simualace pevnych teles
- * VUT FIT, 2018/2019
- *
- * Autor:	Denis Leitner, xleitn02
- * Subor:	Main.h
- *
- */
-
-#pragma once
-
-#ifndef MAIN_H
-#define MAIN_H
-
-#include "Simulation.h"
-
-// screen size
-unsigned int SCREEN_WIDTH = 1280;
-unsigned int SCREEN_HEIGHT = 720;
-
-#endif 
+/**
+ * Bakalarska praca - Simualace pevnych teles
+ * VUT FIT, 2018/2019
+ *
+ * Autor:	Denis Leitner, xleitn02
+ * Subor:	Main.h
+ *
+ */
+
+#pragma once
+
+#ifndef MAIN_H
+#define MAIN_H
+
+#include "Simulation.h"
+
+// screen size
+unsigned int SCREEN_WIDTH = 1280;
+unsigned int SCREEN_HEIGHT = 720;
+
+#endif 
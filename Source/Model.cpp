@@ -1,22 +1,95 @@
-/**
- * Bakalarska praca - Simualace pevnych teles
- * VUT FIT, 2018/2019
- *
- * Autor:	Denis Leitner, xleitn02
- * Subor:	Model.cpp
- *
- */
-
-#include "Model.h"
-
-Model::Model(std::string name)
-{
-	modelName = name;
-	shape = NULL;
-}
-
-Model::~Model()
-{
-	if (shape != NULL)
-		delete shape;
-}
+/**
+ * Bakalarska praca - Simualace pevnych teles
+ * VUT FIT, 2018/2019
+ *
+ * Autor:	Denis Leitner, xleitn02
+ * Subor:	Model.cpp
+ *
+ */
+
+#include "Model.h"
+#include "Compound.h"
+#include "HalfSpace.h"
+#include "TriangleMesh.h"
+#include "Hull.h"
+#include "Sphere.h"
+
+Model::Model(std::string name)
+{
+	modelName = name;
+	shape = NULL;
+	localCenter = glm::vec3(0.0f);
+	localHalfExtents = glm::vec3(0.0f);
+	tightBounds = false;
+}
+
+Model::~Model()
+{
+	if (shape != NULL)
+		delete shape;
+}
+
+void Model::computeLocalBounds()
+{
+	if (shape->type == sphere)
+	{
+		Sphere* sphere = static_cast<Sphere*>(shape);
+		localCenter = glm::vec3(0.0f);
+		localHalfExtents = glm::vec3(sphere->radius);
+		return;
+	}
+
+	if (shape->type == halfSpace)
+	{
+		// bounds of the rendered model
+		HalfSpace* space = static_cast<HalfSpace*>(shape);
+		localCenter = 0.5f * (space->boundsMin + space->boundsMax);
+		localHalfExtents = 0.5f * (space->boundsMax - space->boundsMin);
+		return;
+	}
+
+	if (shape->type == mesh)
+	{
+		TriangleMesh* triangleMesh = static_cast<TriangleMesh*>(shape);
+		localCenter = 0.5f * (triangleMesh->boundsMin + triangleMesh->boundsMax);
+		localHalfExtents = 0.5f * (triangleMesh->boundsMax - triangleMesh->boundsMin);
+		return;
+	}
+
+	if (shape->type == compound)
+	{
+		// union of bounds of children
+		Compound* compoundShape = static_cast<Compound*>(shape);
+		if (compoundShape->children.empty())
+			return;
+
+		glm::vec3 minCoords = compoundShape->children[0].boundsMin;
+		glm::vec3 maxCoords = compoundShape->children[0].boundsMax;
+
+		for (auto & child : compoundShape->children)
+		{
+			minCoords = glm::min(minCoords, child.boundsMin);
+			maxCoords = glm::max(maxCoords, child.boundsMax);
+		}
+
+		localCenter = 0.5f * (minCoords + maxCoords);
+		localHalfExtents = 0.5f * (maxCoords - minCoords);
+		return;
+	}
+
+	Hull* hull = static_cast<Hull*>(shape);
+	if (hull->vertices.empty())
+		return;
+
+	glm::vec3 minCoords = hull->vertices[0]->position;
+	glm::vec3 maxCoords = hull->vertices[0]->position;
+
+	for (auto & vertex : hull->vertices)
+	{
+		minCoords = glm::min(minCoords, vertex->position);
+		maxCoords = glm::max(maxCoords, vertex->position);
+	}
+
+	localCenter = 0.5f * (minCoords + maxCoords);
+	localHalfExtents = 0.5f * (maxCoords - minCoords);
+}
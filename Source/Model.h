@@ -1,85 +1,101 @@
-/**
- * Bakalarska praca - Simualace pevnych teles
- * VUT FIT, 2018/2019
- *
- * Autor:	Denis Leitner, xleitn02
- * Subor:	Model.h
- *
- */
-
-#pragma once
-
-#ifndef MODEL_H
-#define MODEL_H
-
-#include <vector>
-#include <iostream>
-#include <string>
-#include <stdio.h>
-#include <string.h>
-#include <map>
-#include <glm/glm.hpp>
-
-#include "Shape.h"
-
-constexpr auto EPSILON = 0.00001f;
-
-// forward declarations
-class Hull;
-class Object;
-
-/**
- * @brief Structure representing vertex, storing it's position and normal
- */
-typedef struct vertex {
-	/// position of the vertex
-	glm::vec3 position;
-	/// normal of the vertex
-	glm::vec3 normal;
-
-	bool operator<(const vertex that) const
-	{
-		return memcmp((void*)this, (void*)&that, sizeof(struct vertex)) > 0;
-	};
-} Vertex;
-
-/**
- * @brief Class representing 3D model
- */
-class Model
-{
-public:
-	// Name of the model
-	std::string modelName;
-
-	// shape representing this model
-	Shape* shape;
-
-	// Buffer for storing vertex data 
-	// !!! after data are sent to GPU it is deleted !!!
-	std::vector <Vertex> vertexBuffer;
-
-	// Buffer for storing indices to vertices
-	// !!! after data are sent to GPU it is deleted !!!
-	std::vector<unsigned int> indexBuffer;
-
-	// all model vertices
-	// !!! after data are sent to GPU it is deleted !!!
-	std::vector<glm::vec3> vertices;
-
-	// all model normals
-	// !!! after data are sent to GPU it is deleted !!!
-	std::vector<glm::vec3> normals;
-
-	// number of vertices to draw
-	unsigned int verticesCount;
-
-	// vertex array object of the model
-	unsigned int vao;
-
-	Model(std::string name);
-
-	~Model();
-};
-
+/**
+ * Bakalarska praca - Simualace pevnych teles
+ * VUT FIT, 2018/2019
+ *
+ * Autor:	Denis Leitner, xleitn02
+ * Subor:	Model.h
+ *
+ */
+
+#pragma once
+
+#ifndef MODEL_H
+#define MODEL_H
+
+#include <vector>
+#include <iostream>
+#include <string>
+#include <stdio.h>
+#include <string.h>
+#include <map>
+#include <glm/glm.hpp>
+
+#include "Shape.h"
+
+constexpr auto EPSILON = 0.00001f;
+
+// forward declarations
+class Hull;
+class Object;
+
+/**
+ * @brief Structure representing vertex, storing it's position and normal
+ */
+typedef struct vertex {
+	/// position of the vertex
+	glm::vec3 position;
+	/// normal of the vertex
+	glm::vec3 normal;
+
+	bool operator<(const vertex that) const
+	{
+		return memcmp((void*)this, (void*)&that, sizeof(struct vertex)) > 0;
+	};
+} Vertex;
+
+/**
+ * @brief Class representing 3D model
+ */
+class Model
+{
+public:
+	// Name of the model
+	std::string modelName;
+
+	// shape representing this model
+	Shape* shape;
+
+	// Buffer for storing vertex data 
+	// !!! after data are sent to GPU it is deleted !!!
+	std::vector <Vertex> vertexBuffer;
+
+	// Buffer for storing indices to vertices
+	// !!! after data are sent to GPU it is deleted !!!
+	std::vector<unsigned int> indexBuffer;
+
+	// all model vertices
+	// !!! after data are sent to GPU it is deleted !!!
+	std::vector<glm::vec3> vertices;
+
+	// all model normals
+	// !!! after data are sent to GPU it is deleted !!!
+	std::vector<glm::vec3> normals;
+
+	// number of vertices to draw
+	unsigned int verticesCount;
+
+	// vertex array object of the model
+	unsigned int vao;
+
+	// centre and half extents of local-space AABB of the shape
+	glm::vec3 localCenter;
+	glm::vec3 localHalfExtents;
+	// whether world-space AABB is found from extreme vertices of the hull instead of local AABB
+	bool tightBounds;
+
+	// "m" line of scene file that defined the model and "c" lines that added children to compound model,
+	// scene is saved from them
+	std::string definition;
+	std::string childDefinitions;
+
+	Model(std::string name);
+
+	/**
+	 * @brief Computes local-space AABB of the shape, must be called after shape is built
+	 */
+	void computeLocalBounds();
+
+	~Model();
+};
+
 #endif
\ No newline at end of file
@@ -1,280 +1,412 @@
-/**
- * Bakalarska praca - Simualace pevnych teles
- * VUT FIT, 2018/2019
- *
- * Autor:	Denis Leitner, xleitn02
- * Subor:	ModelManager.cpp
- *
- */
-
-#include "ModelManager.h"
-
-ModelManager::ModelManager() {}
-
-ModelManager::~ModelManager()
-{
-	for (auto it = models.begin(); it != models.end(); it++)
-	{
-		delete *it;
-	}
-	models.clear();
-}
-
-bool ModelManager::loadModel(fs::path modelFile, std::string name, ShapeType modelType, float radius)
-{
-	bool result = true;
-
-	std::ifstream file; 
-	
-	file.open(modelFile);
-
-	if (file.is_open())
-	{
-		Model *model;
-
-		try
-		{
-			model = new Model(name);
-
-			switch (modelType)
-			{
-			case sphere:
-				model->shape = new Sphere(radius);
-				break;
-			case hull:
-				model->shape = new Hull();
-				break;
-			case plane:
-				model->shape = new PlaneShape();
-				break;
-			}
-		}
-		catch (...)
-		{
-			printAllocErrorMsg("for geometry model.");
-			return false;
-		}
-
-		// line read from file
-		std::string line;
-
-		unsigned int index = 0;
-
-		// Associative array for Vertex and its index
-		std::map <Vertex, unsigned int> verticesMap;
-		std::pair<std::map <Vertex, unsigned int>::iterator, bool> p;
-
-		std::cout << "Loading " << modelFile << std::endl;
-
-		while (file)
-		{
-			std::getline(file, line);
-			std::string lineHeader = line.substr(0, 2);
-			std::stringstream stream;
-
-			if (lineHeader == "v ")
-			{
-				// line represents vertex position
-				stream << line.substr(2);
-
-				glm::vec3 vertexPosition;
-				stream >> vertexPosition.x; stream >> vertexPosition.y; stream >> vertexPosition.z;
-				model->vertices.push_back(vertexPosition);
-
-				if (modelType == hull || modelType == plane)
-				{
-					Hull* hull = dynamic_cast<Hull*>(model->shape);
-					if (!hull->addVertex(vertexPosition))
-					{
-						printAllocErrorMsg("for hull vertex.");
-						return false;
-					}
-				}
-			}
-			else if (lineHeader == "vn")
-			{
-				// line represents vertex normal
-				stream << line.substr(2);
-				
-				glm::vec3 normal;
-				stream >> normal.x; stream >> normal.y; stream >> normal.z;
-				normal = glm::normalize(normal);
-				model->normals.push_back(normal);
-			}
-			else if (lineHeader == "vt")
-			{
-				// line represents texture coordinate, not implemented
-			}
-			else if (lineHeader == "f ")
-			{
-				// line represents face
-
-				std::string indices[3];
-				
-				int vertexIndices[3];
-				int normalIndices[3];
-
-				stream << line.substr(2);
-				stream >> indices[0]; stream >> indices[1]; stream >> indices[2];
-
-				const char *ind[3] = {
-					indices[0].c_str(),
-					indices[1].c_str(),
-					indices[2].c_str() };
-
-				for (int i = 0; i < 3; i++)
-				{
-					sscanf(ind[i], "%d//%d", &(vertexIndices[i]), &(normalIndices[i]));
-
-					// decrease value of index, because .obj file starts indexing from 1
-					vertexIndices[i]--;
-					normalIndices[i]--;
-				}
-
-				glm::vec3 normal = model->normals[normalIndices[0]];
-
-				if (modelType == hull || modelType == plane)
-				{
-					Hull* hull = dynamic_cast<Hull*>(model->shape);
-					if (!hull->addFace(vertexIndices[0], vertexIndices[1], vertexIndices[2], normal))
-					{
-						printAllocErrorMsg("for hull face.");
-						return false;
-					}
-				}
-
-				for (int i = 0; i < 3; i++)
-				{
-					Vertex v;
-					v.position = model->vertices[vertexIndices[i]];
-					v.normal = model->normals[normalIndices[i]];
-
-					p = verticesMap.insert(std::make_pair(v, index));
-
-					if (p.second == false)
-					{
-						// same vertex is already in vertex buffer, insert its index into the index buffer
-						model->indexBuffer.push_back((*(p.first)).second);
-					}
-					else
-					{
-						// vertex is not yet in vertex buffer
-						model->vertexBuffer.push_back(v);
-						model->indexBuffer.push_back(index);
-						index++;
-					}
-				}
-			}
-		}
-
-		if (modelType == hull || modelType == plane)
-		{
-			Hull* hull = dynamic_cast<Hull*>(model->shape);
-			hull->finalizeBuild();
-		}
-
-		// store pointer to the loaded model
-		models.push_back(model);
-		std::cout << "Loaded" << std::endl;
-		file.close();
-	}
-	else
-	{
-		std::cout << "Loading failed! Could not open file " << modelFile << std::endl;
-		result = false;
-	}
-	return result;
-}
-
-void ModelManager::deleteModel(std::string name)
-{
-	for (unsigned int i = 0; i < models.size(); i++)
-	{
-		if (models[i]->modelName == name)
-		{
-			delete models[i];
-			models.erase(models.begin() + i);
-		}
-	}
-}
-
-Model* ModelManager::getModel(std::string name)
-{
-	std::vector <Model*>::iterator it;
-
-	for (it = models.begin(); it != models.end(); it++)
-	{
-		if ((*it)->modelName == name)
-			return *it;
-	}
-	return NULL;
-}
-
-void ModelManager::createVAOs()
-{
-	std::vector <Model*>::iterator it;
-
-	//for (unsigned int i = 0; i < models.size(); i++)
-	for (it = models.begin(); it != models.end(); it++)
-	{
-		Model *model = *it;
-		model->verticesCount = model->indexBuffer.size();
-
-		unsigned int vbo, ebo;
-
-		// generate buffers
-		glGenVertexArrays(1, &(model->vao));
-		glGenBuffers(1, &vbo);
-		glGenBuffers(1, &ebo);
-		
-		glBindVertexArray(model->vao);
-
-		// buffer for vertex data
-		glBindBuffer(GL_ARRAY_BUFFER, vbo);
-		glBufferData(GL_ARRAY_BUFFER, model->vertexBuffer.size() * sizeof(Vertex), &(model->vertexBuffer[0]), GL_STATIC_DRAW);
-
-		// buffer for indices
-		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo);
-		glBufferData(GL_ELEMENT_ARRAY_BUFFER, model->verticesCount * sizeof(unsigned int), &(model->indexBuffer[0]), GL_STATIC_DRAW);
-
-		// vertex position attribute
-		glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 2 * sizeof(glm::vec3), (void*)0);
-		glEnableVertexAttribArray(0);
-
-		// vertex normal attribute
-		glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 2 * sizeof(glm::vec3), (void*)(sizeof(glm::vec3)));
-		glEnableVertexAttribArray(1);
-
-		// data are stored in GPU so they can be deleted from memory
-		model->vertexBuffer.clear();
-		model->indexBuffer.clear();
-		model->vertices.clear();
-		model->normals.clear();
-	}
-}
-
-void ModelManager::insertEdge(unsigned int vertex0, unsigned int vertex1, unsigned int normal, std::map<std::pair<unsigned int, unsigned int>, unsigned int>* edges)
-{
-	// find if same edge with opposite direction is already in map
-	auto iterator = edges->find(std::make_pair(vertex1, vertex0));
-
-	// edge with opposite direction is not there yet
-	if (iterator == edges->end())
-	{
-		std::pair<unsigned int, unsigned int> edge = std::make_pair(vertex0, vertex1);
-		edges->insert(std::make_pair(edge, normal));
-	}
-	else
-	{
-		// it has same normal so it is not reallly an edge of the object 
-		if ((*iterator).second == normal)
-		{
-			edges->erase(iterator);
-		}
-	}
-}
-
-void ModelManager::printAllocErrorMsg(std::string what)
-{
-	std::cout << "Couldn't allocate memory for " << what << std::endl;
-}
+/**
+ * Bakalarska praca - Simualace pevnych teles
+ * VUT FIT, 2018/2019
+ *
+ * Autor:	Denis Leitner, xleitn02
+ * Subor:	ModelManager.cpp
+ *
+ */
+
+#include "ModelManager.h"
+#include "Object.h"
+#include <memory>
+
+ModelManager::ModelManager() {}
+
+ModelManager::~ModelManager()
+{
+	for (auto it = models.begin(); it != models.end(); it++)
+	{
+		delete *it;
+	}
+	models.clear();
+}
+
+bool ModelManager::loadModel(fs::path modelFile, std::string name, ShapeType modelType, float radius, bool tightBounds, bool bounded,
+	unsigned proxyVertices)
+{
+	bool result = true;
+
+	std::ifstream file; 
+	
+	file.open(modelFile);
+
+	if (file.is_open())
+	{
+		// model is owned here until it is registered, so it is freed when loading fails
+		std::unique_ptr<Model> model;
+
+		try
+		{
+			model.reset(new Model(name));
+
+			switch (modelType)
+			{
+			case sphere:
+				model->shape = new Sphere(radius);
+				break;
+			case hull:
+				model->shape = new Hull();
+				break;
+			case plane:
+				model->shape = new PlaneShape();
+				break;
+			case halfSpace:
+				model->shape = new HalfSpace();
+				break;
+			case mesh:
+				model->shape = new TriangleMesh();
+				break;
+			case box:
+			case compound:
+			case none:
+			default:
+				// boxes are detected from hulls, compounds are created from other models
+				std::cout << "Loading failed! Shape of " << modelFile << " can't be loaded from file" << std::endl;
+				return false;
+			}
+		}
+		catch (...)
+		{
+			printAllocErrorMsg("for geometry model.");
+			return false;
+		}
+
+		// line read from file
+		std::string line;
+
+		unsigned int index = 0;
+
+		// Associative array for Vertex and its index
+		std::map <Vertex, unsigned int> verticesMap;
+		std::pair<std::map <Vertex, unsigned int>::iterator, bool> p;
+
+		// proxy hull is built from all vertices after the file is read
+		bool faceHull = modelType == plane || (modelType == hull && proxyVertices == 0);
+
+		std::cout << "Loading " << modelFile << std::endl;
+
+		while (file)
+		{
+			std::getline(file, line);
+			std::string lineHeader = line.substr(0, 2);
+			std::stringstream stream;
+
+			if (lineHeader == "v ")
+			{
+				// line represents vertex position
+				stream << line.substr(2);
+
+				glm::vec3 vertexPosition;
+				stream >> vertexPosition.x; stream >> vertexPosition.y; stream >> vertexPosition.z;
+				model->vertices.push_back(vertexPosition);
+
+				if (faceHull)
+				{
+					Hull* hull = dynamic_cast<Hull*>(model->shape);
+					if (!hull->addVertex(vertexPosition))
+					{
+						printAllocErrorMsg("for hull vertex.");
+						return false;
+					}
+				}
+			}
+			else if (lineHeader == "vn")
+			{
+				// line represents vertex normal
+				stream << line.substr(2);
+				
+				glm::vec3 normal;
+				stream >> normal.x; stream >> normal.y; stream >> normal.z;
+				normal = glm::normalize(normal);
+				model->normals.push_back(normal);
+			}
+			else if (lineHeader == "vt")
+			{
+				// line represents texture coordinate, not implemented
+			}
+			else if (lineHeader == "f ")
+			{
+				// line represents face
+
+				std::string indices[3];
+				
+				int vertexIndices[3];
+				int normalIndices[3];
+
+				stream << line.substr(2);
+				stream >> indices[0]; stream >> indices[1]; stream >> indices[2];
+
+				const char *ind[3] = {
+					indices[0].c_str(),
+					indices[1].c_str(),
+					indices[2].c_str() };
+
+				for (int i = 0; i < 3; i++)
+				{
+					sscanf(ind[i], "%d//%d", &(vertexIndices[i]), &(normalIndices[i]));
+
+					// decrease value of index, because .obj file starts indexing from 1
+					vertexIndices[i]--;
+					normalIndices[i]--;
+				}
+
+				glm::vec3 normal = model->normals[normalIndices[0]];
+
+				if (faceHull)
+				{
+					Hull* hull = dynamic_cast<Hull*>(model->shape);
+					if (!hull->addFace(vertexIndices[0], vertexIndices[1], vertexIndices[2], normal))
+					{
+						printAllocErrorMsg("for hull face.");
+						return false;
+					}
+				}
+
+				if (modelType == mesh)
+				{
+					TriangleMesh* triangleMesh = static_cast<TriangleMesh*>(model->shape);
+					triangleMesh->addTriangle(model->vertices[vertexIndices[0]], model->vertices[vertexIndices[1]],
+						model->vertices[vertexIndices[2]], normal);
+				}
+
+				for (int i = 0; i < 3; i++)
+				{
+					Vertex v;
+					v.position = model->vertices[vertexIndices[i]];
+					v.normal = model->normals[normalIndices[i]];
+
+					p = verticesMap.insert(std::make_pair(v, index));
+
+					if (p.second == false)
+					{
+						// same vertex is already in vertex buffer, insert its index into the index buffer
+						model->indexBuffer.push_back((*(p.first)).second);
+					}
+					else
+					{
+						// vertex is not yet in vertex buffer
+						model->vertexBuffer.push_back(v);
+						model->indexBuffer.push_back(index);
+						index++;
+					}
+				}
+			}
+		}
+
+		if (modelType == hull || modelType == plane)
+		{
+			Hull* hull = dynamic_cast<Hull*>(model->shape);
+
+			if (!faceHull && !hull->buildFromPoints(model->vertices, proxyVertices))
+			{
+				std::cout << "Loading failed! Collision proxy of " << modelFile << " can't be built, model is flat" << std::endl;
+				return false;
+			}
+
+			if (!hull->finalizeBuild())
+			{
+				std::cout << "Loading failed! Hull in " << modelFile << " has too many elements or too large face" << std::endl;
+				return false;
+			}
+
+			// planes are open hulls, only closed hulls can be boxes
+			if (modelType != plane)
+				hull->detectBox();
+
+			// tight bounds only for elongated hulls whose local AABB fits badly when rotated
+			model->tightBounds = tightBounds;
+		}
+		else if (modelType == halfSpace)
+		{
+			// boundary plane is given by the model, which has to be flat
+			HalfSpace* space = dynamic_cast<HalfSpace*>(model->shape);
+			if (model->normals.empty() || !space->setBoundary(model->vertices, model->normals[0], bounded))
+			{
+				std::cout << "Loading failed! Half-space in " << modelFile << " has no face or isn't flat" << std::endl;
+				return false;
+			}
+		}
+		else if (modelType == mesh)
+		{
+			// hierarchy of triangles is built once, mesh can't move
+			TriangleMesh* triangleMesh = static_cast<TriangleMesh*>(model->shape);
+			if (!triangleMesh->build())
+			{
+				std::cout << "Loading failed! Mesh in " << modelFile << " has no triangle" << std::endl;
+				return false;
+			}
+		}
+
+		model->computeLocalBounds();
+
+		// store pointer to the loaded model
+		models.push_back(model.get());
+		modelNames.emplace(name, model.release());
+		std::cout << "Loaded" << std::endl;
+		file.close();
+	}
+	else
+	{
+		std::cout << "Loading failed! Could not open file " << modelFile << std::endl;
+		result = false;
+	}
+	return result;
+}
+
+bool ModelManager::createCompound(std::string name)
+{
+	std::unique_ptr<Model> model;
+
+	try
+	{
+		model.reset(new Model(name));
+		model->shape = new Compound();
+	}
+	catch (...)
+	{
+		printAllocErrorMsg("for compound model.");
+		return false;
+	}
+
+	models.push_back(model.get());
+	modelNames.emplace(name, model.release());
+	return true;
+}
+
+bool ModelManager::addCompoundChild(std::string compoundName, std::string childName, glm::vec3 position, glm::vec3 rotation)
+{
+	Model* model = getModel(compoundName);
+	Model* child = getModel(childName);
+
+	if (model == NULL || model->shape->type != compound || child == NULL)
+	{
+		std::cout << "Compound " << compoundName << " or its child " << childName << " not found" << std::endl;
+		return false;
+	}
+
+	glm::mat3 rotationMatrix = Object::constructRotationMatrix(rotation);
+	Compound* shape = static_cast<Compound*>(model->shape);
+
+	if (!shape->addChild(child, position, rotationMatrix))
+	{
+		std::cout << "Model " << childName << " can't be child of compound " << compoundName
+			<< ", only hulls and spheres can be children, at most " << MAX_COMPOUND_CHILDREN << std::endl;
+		return false;
+	}
+
+	// compound is rendered as meshes of its children
+	unsigned int offset = model->vertexBuffer.size();
+
+	for (auto & vertex : child->vertexBuffer)
+	{
+		Vertex v;
+		v.position = rotationMatrix * vertex.position + position;
+		v.normal = rotationMatrix * vertex.normal;
+		model->vertexBuffer.push_back(v);
+	}
+
+	for (auto & index : child->indexBuffer)
+		model->indexBuffer.push_back(index + offset);
+
+	model->computeLocalBounds();
+	return true;
+}
+
+void ModelManager::deleteModel(std::string name)
+{
+	for (unsigned int i = 0; i < models.size(); i++)
+	{
+		if (models[i]->modelName == name)
+		{
+			delete models[i];
+			models.erase(models.begin() + i);
+		}
+	}
+
+	// another model of the same name may remain
+	modelNames.erase(name);
+	for (auto & model : models)
+	{
+		if (model->modelName == name)
+		{
+			modelNames.emplace(name, model);
+			break;
+		}
+	}
+}
+
+Model* ModelManager::getModel(const std::string& name)
+{
+	auto it = modelNames.find(name);
+	return it != modelNames.end() ? it->second : NULL;
+}
+
+void ModelManager::createVAOs()
+{
+	std::vector <Model*>::iterator it;
+
+	//for (unsigned int i = 0; i < models.size(); i++)
+	for (it = models.begin(); it != models.end(); it++)
+	{
+		Model *model = *it;
+		model->verticesCount = model->indexBuffer.size();
+
+		unsigned int vbo, ebo;
+
+		// generate buffers
+		glGenVertexArrays(1, &(model->vao));
+		glGenBuffers(1, &vbo);
+		glGenBuffers(1, &ebo);
+		
+		glBindVertexArray(model->vao);
+
+		// buffer for vertex data
+		glBindBuffer(GL_ARRAY_BUFFER, vbo);
+		glBufferData(GL_ARRAY_BUFFER, model->vertexBuffer.size() * sizeof(Vertex), &(model->vertexBuffer[0]), GL_STATIC_DRAW);
+
+		// buffer for indices
+		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo);
+		glBufferData(GL_ELEMENT_ARRAY_BUFFER, model->verticesCount * sizeof(unsigned int), &(model->indexBuffer[0]), GL_STATIC_DRAW);
+
+		// vertex position attribute
+		glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 2 * sizeof(glm::vec3), (void*)0);
+		glEnableVertexAttribArray(0);
+
+		// vertex normal attribute
+		glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 2 * sizeof(glm::vec3), (void*)(sizeof(glm::vec3)));
+		glEnableVertexAttribArray(1);
+
+		// data are stored in GPU so they can be deleted from memory
+		model->vertexBuffer.clear();
+		model->indexBuffer.clear();
+		model->vertices.clear();
+		model->normals.clear();
+	}
+}
+
+void ModelManager::insertEdge(unsigned int vertex0, unsigned int vertex1, unsigned int normal, std::map<std::pair<unsigned int, unsigned int>, unsigned int>* edges)
+{
+	// find if same edge with opposite direction is already in map
+	auto iterator = edges->find(std::make_pair(vertex1, vertex0));
+
+	// edge with opposite direction is not there yet
+	if (iterator == edges->end())
+	{
+		std::pair<unsigned int, unsigned int> edge = std::make_pair(vertex0, vertex1);
+		edges->insert(std::make_pair(edge, normal));
+	}
+	else
+	{
+		// it has same normal so it is not reallly an edge of the object 
+		if ((*iterator).second == normal)
+		{
+			edges->erase(iterator);
+		}
+	}
+}
+
+void ModelManager::printAllocErrorMsg(std::string what)
+{
+	std::cout << "Couldn't allocate memory for " << what << std::endl;
+}
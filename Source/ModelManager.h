@@ -1,96 +1,125 @@
-/**
- * Bakalarska praca - Simualace pevnych teles
- * VUT FIT, 2018/2019
- *
- * Autor:	Denis Leitner, xleitn02
- * Subor:	ModelManager.h
- *
- */
-
-#pragma once
-#pragma warning(disable:4996)
-
-#ifndef MODEL_MANAGER_H
-#define MODEL_MANAGER_H
-
-#define GLM_ENABLE_EXPERIMENTAL
-
-#include <iostream>
-#include <fstream>
-#include <string>
-#include <vector>
-#include <sstream>
-#include <map>
-#include <stdio.h>
-#include <glm/glm.hpp>
-#include <filesystem>
-
-#include <glad/glad.h>
-#include <GLFW/glfw3.h>
-
-#include "helpers/RootDir.h"
-#include "Model.h"
-#include "Hull.h"
-#include "PlaneShape.h"
-#include "Sphere.h"
-
-namespace fs = std::filesystem;
-
-/**
- * @brief Class for managing 3D models
- */
-class ModelManager
-{
-public:
-	// All models are stored here
-	std::vector <Model*> models;
-
-	ModelManager();
-
-	/**
-	 * @brief Destructor, deletes all stored models
-	 */
-	~ModelManager();
-
-	/**
-	 * @brief				Loads 3D model from .obj file, only files with vertex and normal positions
-	 * @param modelFile		Path to file from which 3D model will be loaded
-	 * @param name			Name of the model to be stored
-	 * @param modelType		Type of the model shape, e.g. sphere, hull,...
-	 * @return				Returns true on success, else returns false
-	 */
-	bool loadModel(fs::path modelFile, std::string name, ShapeType modelType, float radius);
-
-	/**
-	 * @brief		Deletes model from memory
-	 * @param name	Name of the model to be deleted
-	 */
-	void deleteModel(std::string name);
-
-	/**
-	 * @brief			Gets pointer to the model
-	 * @param name		Name of the model whose pointer to get
-	 * @return			Pointer to the model of given name, NULL if model with given name doesn't exist
-	 */
-	Model* getModel(std::string name);
-
-	/**
-	 * @brief Creates GPU buffers and configurations of vertex attributes for all models 
-	 */
-	void createVAOs();
-
-	/**
-	 * @brief Inserts edge only if the same edge is not already in
-	 * @param vertex0	Index of first vertex of the edge
-	 * @param vertex0	Index of second vertex of the edge
-	 * @param normal	Index of normal of the edge
-	 * @param edges		Multimap into which to insert edge
-	 */
-	void insertEdge(unsigned int vertex0, unsigned int vertex1, unsigned int normal, 
-		std::map<std::pair<unsigned int, unsigned int>, unsigned int> *edges);
-
-private:
-	void printAllocErrorMsg(std::string what);
-};
-
+/**
+ * Bakalarska praca - Simualace pevnych teles
+ * VUT FIT, 2018/2019
+ *
+ * Autor:	Denis Leitner, xleitn02
+ * Subor:	ModelManager.h
+ *
+ */
+
+#pragma once
+#pragma warning(disable:4996)
+
+#ifndef MODEL_MANAGER_H
+#define MODEL_MANAGER_H
+
+#define GLM_ENABLE_EXPERIMENTAL
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <sstream>
+#include <map>
+#include <unordered_map>
+#include <stdio.h>
+#include <glm/glm.hpp>
+#include <filesystem>
+
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
+#include "helpers/RootDir.h"
+#include "Model.h"
+#include "Compound.h"
+#include "HalfSpace.h"
+#include "Hull.h"
+#include "PlaneShape.h"
+#include "Sphere.h"
+#include "TriangleMesh.h"
+
+namespace fs = std::filesystem;
+
+/**
+ * @brief Class for managing 3D models
+ */
+class ModelManager
+{
+public:
+	// All models are stored here
+	std::vector <Model*> models;
+
+	ModelManager();
+
+	/**
+	 * @brief Destructor, deletes all stored models
+	 */
+	~ModelManager();
+
+	/**
+	 * @brief				Loads 3D model from .obj file, only files with vertex and normal positions
+	 * @param modelFile		Path to file from which 3D model will be loaded
+	 * @param name			Name of the model to be stored
+	 * @param modelType		Type of the model shape, e.g. sphere, hull,...
+	 * @param tightBounds	Whether AABBs of objects of the model are found from extreme vertices of the hull
+	 * @param bounded		Whether half-space is limited to bounds of the model, used only for half-spaces
+	 * @param proxyVertices	Upper limit of vertices of collision hull built as convex hull of the model, used only for hulls;
+	 *						0 builds hull from faces of the model, rendered mesh is the same in both cases
+	 * @return				Returns true on success, else returns false
+	 */
+	bool loadModel(fs::path modelFile, std::string name, ShapeType modelType, float radius, bool tightBounds = false, bool bounded = false,
+		unsigned proxyVertices = 0);
+
+	/**
+	 * @brief		Creates compound model without children, children are added by addCompoundChild
+	 * @param name	Name of the model to be stored
+	 * @return		Returns true on success, else returns false
+	 */
+	bool createCompound(std::string name);
+
+	/**
+	 * @brief				Adds child to compound model, mesh of the child is added to mesh of the compound
+	 * @param compoundName	Name of compound model
+	 * @param childName		Name of already loaded hull or sphere model used as the child
+	 * @param position		Position of the child in local space of the compound
+	 * @param rotation		Rotation of the child in local space of the compound, Euler angles in degrees
+	 * @return				Returns true on success, else returns false
+	 */
+	bool addCompoundChild(std::string compoundName, std::string childName, glm::vec3 position, glm::vec3 rotation);
+
+	/**
+	 * @brief		Deletes model from memory
+	 * @param name	Name of the model to be deleted
+	 */
+	void deleteModel(std::string name);
+
+	/**
+	 * @brief			Gets pointer to the model
+	 * @param name		Name of the model whose pointer to get
+	 * @return			Pointer to the model of given name, NULL if model with given name doesn't exist
+	 */
+	Model* getModel(const std::string& name);
+
+	/**
+	 * @brief Creates GPU buffers and configurations of vertex attributes for all models 
+	 */
+	void createVAOs();
+
+	/**
+	 * @brief Inserts edge only if the same edge is not already in
+	 * @param vertex0	Index of first vertex of the edge
+	 * @param vertex0	Index of second vertex of the edge
+	 * @param normal	Index of normal of the edge
+	 * @param edges		Multimap into which to insert edge
+	 */
+	void insertEdge(unsigned int vertex0, unsigned int vertex1, unsigned int normal, 
+		std::map<std::pair<unsigned int, unsigned int>, unsigned int> *edges);
+
+private:
+	// models by their names, the first loaded model of given name is found
+	std::unordered_map<std::string, Model*> modelNames;
+
+	void printAllocErrorMsg(std::string what);
+};
+
 #endif
\ No newline at end of file
@@ -1,114 +1,145 @@
-/**
- * Bakalarska praca - Simualace pevnych teles
- * VUT FIT, 2018/2019
- *
- * Autor:	Denis Leitner, xleitn02
- * Subor:	Object.h
- *
- */
-
-#pragma once
-
-#ifndef OBJECT_H
-#define OBJECT_H
-
-#define GLM_ENABLE_EXPERIMENTAL
-#include <glm/gtc/matrix_transform.hpp>
-
-#include "Hull.h"
-#include "Model.h"
-#include "Sphere.h"
-
-class AABB
-{
-public:
-	glm::vec3 min;	// minimal coordinates along each axis
-	glm::vec3 max;	// maximal coordinates along each axis
-
-	/**
-	 * @brief Creates new AABB for given object
-	 * @param object Object for which to create AABB
-	 */
-	AABB(Object* object);
-
-	/**
-	 * @brief Computes AABB for given Object
-	 * @param object Object for which to recompute AABB
-	 */
-	void recomputeAABB(Object* object);
-
-private:
-	/**
-	 * @brief Assigns value to min if value is lesser than min, to max if value is greater than max
-	 */
-	void assignMinMax(float value, float& min, float& max);
-};
-
-/**
- * @brief Class representing object
- */
-class Object
-{
-public:
-	// name of the object
-	std::string objectName;
-	// pointer to the model(mesh)
-	Model *model;
-	// axis aligned bounding box of an object
-	AABB *aabb;
-	// color of an object
-	glm::vec3 color;
-	// density of an object
-	float density;
-	float mass;
-	// 1/mass
-	float inverseMass;
-	glm::vec3 centerOfMass;
-
-	// inverse inertia tensor in body-space
-	glm::mat3 inverseBodyInertiaTensor;
-
-	struct Configuration
-	{
-		glm::vec3 position;
-		glm::mat3 rotation;
-
-		glm::vec3 velocityAccumulator;
-		glm::vec3 velocityVector;
-		glm::vec3 angularMomentum;
-
-		glm::vec3 force;
-		glm::vec3 torque;
-
-		// inverse inertia tensor in world-space, must be recomputed every frame
-		glm::mat3 inverseWorldInertiaTensor;
-		glm::vec3 angularVelocity;
-
-		Configuration();
-	} configuration;
-
-	struct ObjectInit
-	{
-		std::string objectName;
-		Model* model;
-		glm::vec3 color;
-		glm::vec3 position;
-		glm::vec3 rotation;
-		glm::vec3 initialVelocity;
-		float density;
-		ObjectInit();
-	};
-
-	Object(ObjectInit initValues);
-	~Object();
-
-	glm::mat4 getModelMatrix();
-	glm::mat3 getRotationMatrix();
-	glm::vec3 getPosition();
-	void computeInverseWorldInertiaTensor();
-	void reorthogonalizeRotationMatrix();
-private:
-	glm::mat3 constructRotationMatrix(glm::vec3 eulerAngles);
-};
-
+/**
+ * Bakalarska praca - Simualace pevnych teles
+ * VUT FIT, 2018/2019
+ *
+ * Autor:	Denis Leitner, xleitn02
+ * Subor:	Object.h
+ *
+ */
+
+#pragma once
+
+#ifndef OBJECT_H
+#define OBJECT_H
+
+#define GLM_ENABLE_EXPERIMENTAL
+#include <glm/gtc/matrix_transform.hpp>
+
+#include "Hull.h"
+#include "Model.h"
+#include "Sphere.h"
+
+class AABB
+{
+public:
+	glm::vec3 min;	// minimal coordinates along each axis
+	glm::vec3 max;	// maximal coordinates along each axis
+
+	/**
+	 * @brief Creates new AABB for given object
+	 * @param object Object for which to create AABB
+	 */
+	AABB(Object* object);
+
+	/**
+	 * @brief Computes AABB for given Object
+	 * @param object Object for which to recompute AABB
+	 */
+	void recomputeAABB(Object* object);
+
+	/**
+	 * @brief Extends AABB so that it covers also its copy moved by given vector
+	 * @param motion Vector by which the copy is moved
+	 */
+	void sweep(const glm::vec3& motion);
+};
+
+/**
+ * @brief Class representing object
+ */
+class Object
+{
+public:
+	// name of the object
+	std::string objectName;
+	// pointer to the model(mesh)
+	Model *model;
+	// axis aligned bounding box of an object
+	AABB *aabb;
+	// extreme vertices of the hull along -x, +x, -y, +y, -z, +z found in the last AABB update,
+	// starting points of the next search
+	uint16_t boundVertices[6];
+	// support vertices of the hull found in the last narrow-phase queries, one for each direction octant
+	uint16_t supportVertices[SUPPORT_CACHE_SLOTS];
+	// faces of hulls closest to the centre of this sphere found in the last hull-sphere tests, keyed by the hull,
+	// starting points of the next ones; a new hull overwrites the oldest slot, any face is a valid starting point
+	const Object* closestFaceHulls[CLOSEST_FACE_SLOTS];
+	uint16_t closestFaces[CLOSEST_FACE_SLOTS];
+	unsigned nextClosestFaceSlot;
+
+	// translation of an object during the last step
+	glm::vec3 stepMotion;
+	// whether object moved so fast during the last step that it's checked by continuous collision detection
+	bool continuous;
+	// color of an object
+	glm::vec3 color;
+	// density of an object
+	float density;
+	float mass;
+	// 1/mass
+	float inverseMass;
+	glm::vec3 centerOfMass;
+
+	// inverse inertia tensor in body-space
+	glm::mat3 inverseBodyInertiaTensor;
+
+	// objects of children of compound shape, placed by updatePart before they are tested
+	std::vector<Object*> parts;
+
+	struct Configuration
+	{
+		glm::vec3 position;
+		glm::mat3 rotation;
+
+		glm::vec3 velocityAccumulator;
+		// displacement accumulated by position solver, moves object out of penetration without changing its momentum;
+		// it is linear only, rotation of the object isn't corrected
+		glm::vec3 pushDisplacement;
+		glm::vec3 velocityVector;
+		glm::vec3 angularMomentum;
+
+		glm::vec3 force;
+		glm::vec3 torque;
+
+		// inverse inertia tensor in world-space, must be recomputed every frame
+		glm::mat3 inverseWorldInertiaTensor;
+		glm::vec3 angularVelocity;
+
+		Configuration();
+	} configuration;
+
+	struct ObjectInit
+	{
+		std::string objectName;
+		Model* model;
+		glm::vec3 color;
+		glm::vec3 position;
+		// rotation matrix, text scene gives it by Euler angles
+		glm::mat3 rotation;
+		glm::vec3 initialVelocity;
+		float density;
+		ObjectInit();
+	};
+
+	Object(ObjectInit initValues);
+	~Object();
+
+	glm::mat4 getModelMatrix();
+	glm::mat3 getRotationMatrix();
+	glm::vec3 getPosition();
+	void computeInverseWorldInertiaTensor();
+	void reorthogonalizeRotationMatrix();
+
+	/**
+	 * @brief Moves object of compound child to the child's place in current configuration of this object
+	 * @param index Index of the child
+	 */
+	void updatePart(unsigned index);
+
+	/**
+	 * @brief Constructs rotation matrix from Euler angles in degrees, rotations are applied in order x, y, z
+	 */
+	static glm::mat3 constructRotationMatrix(glm::vec3 eulerAngles);
+};
+
 #endif
\ No newline at end of file
@@ -1,16 +1,16 @@
-/**
- * Bakalarska praca - Simualace pevnych teles
- * VUT FIT, 2018/2019
- *
- * Autor:	Denis Leitner, xleitn02
- * Subor:	PlaneShape.cpp
- *
- */
-
-#include "PlaneShape.h"
-
-
-PlaneShape::PlaneShape()
-{
-	type = plane;
+/**
+ * Bakalarska praca - Simualace pevnych teles
+ * VUT FIT, 2018/2019
+ *
+ * Autor:	Denis Leitner, xleitn02
+ * Subor:	PlaneShape.cpp
+ *
+ */
+
+#include "PlaneShape.h"
+
+
+PlaneShape::PlaneShape()
+{
+	type = plane;
 }
\ No newline at end of file
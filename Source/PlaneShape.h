@@ -1,23 +1,23 @@
-/**
- * Bakalarska praca - Simualace pevnych teles
- * VUT FIT, 2018/2019
- *
- * Autor:	Denis Leitner, xleitn02
- * Subor:	PlaneShape.h
- *
- */
-
-#pragma once
-
-#ifndef PLANE_H
-#define PLANE_H
-
-#include "Hull.h"
-
-class PlaneShape : public Hull
-{
-public:
-	PlaneShape();
-};
-
+/**
+ * Bakalarska praca - Simualace pevnych teles
+ * VUT FIT, 2018/2019
+ *
+ * Autor:	Denis Leitner, xleitn02
+ * Subor:	PlaneShape.h
+ *
+ */
+
+#pragma once
+
+#ifndef PLANE_H
+#define PLANE_H
+
+#include "Hull.h"
+
+class PlaneShape : public Hull
+{
+public:
+	PlaneShape();
+};
+
 #endif
\ No newline at end of file
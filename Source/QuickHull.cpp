@@ -0,0 +1,334 @@
+/**
+ * Bakalarska praca - Simualace pevnych teles
+ * VUT FIT, 2018/2019
+ *
+ * Autor:	Denis Leitner, xleitn02
+ * Subor:	QuickHull.cpp
+ *
+ */
+
+#include "QuickHull.h"
+#include <algorithm>
+#include <unordered_map>
+#include <unordered_set>
+
+
+bool QuickHull::build(const std::vector<glm::vec3>& points, unsigned maxVertices)
+{
+	std::vector<glm::vec3> remaining = points;
+
+	// vertex inside flat face would close cycle of merged triangles, hull is built again without such vertices
+	while (expand(remaining, maxVertices))
+	{
+		std::vector<unsigned> interior = collectResult(remaining);
+		if (interior.empty())
+			return true;
+
+		std::sort(interior.begin(), interior.end());
+		for (auto it = interior.rbegin(); it != interior.rend(); it++)
+			remaining.erase(remaining.begin() + *it);
+	}
+
+	return false;
+}
+
+bool QuickHull::expand(const std::vector<glm::vec3>& points, unsigned maxVertices)
+{
+	vertices.clear();
+	faces.clear();
+	buildFaces.clear();
+
+	if (points.size() < 4)
+		return false;
+
+	// extreme points along axes, the initial simplex is chosen from them
+	unsigned extremes[6] = { 0, 0, 0, 0, 0, 0 };
+
+	for (unsigned i = 1; i < points.size(); i++)
+	{
+		for (int axis = 0; axis < 3; axis++)
+		{
+			if (points[i][axis] < points[extremes[2 * axis]][axis])
+				extremes[2 * axis] = i;
+			if (points[i][axis] > points[extremes[2 * axis + 1]][axis])
+				extremes[2 * axis + 1] = i;
+		}
+	}
+
+	unsigned simplex[4] = { extremes[0], extremes[1], 0, 0 };
+	float maxDistance = -1.0f;
+
+	for (int i = 0; i < 6; i++)
+	{
+		for (int j = i + 1; j < 6; j++)
+		{
+			float distance = glm::length(points[extremes[i]] - points[extremes[j]]);
+			if (distance > maxDistance)
+			{
+				maxDistance = distance;
+				simplex[0] = extremes[i];
+				simplex[1] = extremes[j];
+			}
+		}
+	}
+
+	if (maxDistance <= 0.0f)
+		return false;
+
+	float tolerance = QUICK_HULL_TOLERANCE * maxDistance;
+
+	// the point farthest from line of the first two points
+	glm::vec3 direction = glm::normalize(points[simplex[1]] - points[simplex[0]]);
+	maxDistance = 0.0f;
+
+	for (unsigned i = 0; i < points.size(); i++)
+	{
+		glm::vec3 offset = points[i] - points[simplex[0]];
+		float distance = glm::length(offset - direction * glm::dot(offset, direction));
+		if (distance > maxDistance)
+		{
+			maxDistance = distance;
+			simplex[2] = i;
+		}
+	}
+
+	if (maxDistance < tolerance)
+		return false;
+
+	// the point farthest from plane of the first three points
+	glm::vec3 normal = glm::normalize(glm::cross(points[simplex[1]] - points[simplex[0]], points[simplex[2]] - points[simplex[0]]));
+	maxDistance = 0.0f;
+
+	for (unsigned i = 0; i < points.size(); i++)
+	{
+		float distance = std::abs(glm::dot(normal, points[i] - points[simplex[0]]));
+		if (distance > maxDistance)
+		{
+			maxDistance = distance;
+			simplex[3] = i;
+		}
+	}
+
+	if (maxDistance < tolerance)
+		return false;
+
+	glm::vec3 inside = 0.25f * (points[simplex[0]] + points[simplex[1]] + points[simplex[2]] + points[simplex[3]]);
+
+	createFace(points, simplex[0], simplex[1], simplex[2], inside);
+	createFace(points, simplex[0], simplex[1], simplex[3], inside);
+	createFace(points, simplex[0], simplex[2], simplex[3], inside);
+	createFace(points, simplex[1], simplex[2], simplex[3], inside);
+
+	std::vector<unsigned> candidates;
+	for (unsigned i = 0; i < points.size(); i++)
+	{
+		if (std::find(simplex, simplex + 4, i) == simplex + 4)
+			candidates.push_back(i);
+	}
+	assignPoints(points, candidates, 0, tolerance);
+
+	unsigned vertexCount = 4;
+
+	while (maxVertices == 0 || vertexCount < maxVertices)
+	{
+		// the point farthest from hull changes its shape the most
+		unsigned eye = 0;
+		float eyeDistance = 0.0f;
+		bool found = false;
+
+		for (auto & face : buildFaces)
+		{
+			if (face.removed)
+				continue;
+
+			for (auto & point : face.outside)
+			{
+				float distance = glm::dot(face.normal, points[point]) - face.offset;
+				if (distance > eyeDistance)
+				{
+					eyeDistance = distance;
+					eye = point;
+					found = true;
+				}
+			}
+		}
+
+		if (!found)
+			break;
+
+		// faces visible from the point are removed, their boundary is horizon
+		std::vector<unsigned> visible;
+		std::unordered_set<unsigned long long> visibleEdges;
+		unsigned long long pointCount = points.size();
+
+		for (unsigned i = 0; i < buildFaces.size(); i++)
+		{
+			BuildFace& face = buildFaces[i];
+			if (face.removed || glm::dot(face.normal, points[eye]) - face.offset <= tolerance)
+				continue;
+
+			visible.push_back(i);
+			for (int j = 0; j < 3; j++)
+				visibleEdges.insert(face.vertices[j] * pointCount + face.vertices[(j + 1) % 3]);
+		}
+
+		candidates.clear();
+		unsigned firstNewFace = buildFaces.size();
+
+		for (auto & index : visible)
+		{
+			// faces are copied, new faces may reallocate the vector
+			unsigned faceVertices[3] = { buildFaces[index].vertices[0], buildFaces[index].vertices[1], buildFaces[index].vertices[2] };
+
+			for (auto & point : buildFaces[index].outside)
+			{
+				if (point != eye)
+					candidates.push_back(point);
+			}
+			buildFaces[index].outside.clear();
+			buildFaces[index].removed = true;
+
+			for (int j = 0; j < 3; j++)
+			{
+				unsigned tail = faceVertices[j];
+				unsigned head = faceVertices[(j + 1) % 3];
+
+				// edge whose twin belongs to face that stays is on horizon
+				if (visibleEdges.find(head * pointCount + tail) == visibleEdges.end())
+					createFace(points, tail, head, eye, inside);
+			}
+		}
+
+		assignPoints(points, candidates, firstNewFace, tolerance);
+		vertexCount++;
+	}
+
+	return true;
+}
+
+void QuickHull::createFace(const std::vector<glm::vec3>& points, unsigned a, unsigned b, unsigned c, const glm::vec3& inside)
+{
+	BuildFace face;
+	face.vertices[0] = a;
+	face.vertices[1] = b;
+	face.vertices[2] = c;
+	face.normal = glm::cross(points[b] - points[a], points[c] - points[a]);
+	face.removed = false;
+
+	float length = glm::length(face.normal);
+	face.normal = length > 0.0f ? face.normal / length : glm::normalize(points[a] - inside);
+
+	if (glm::dot(face.normal, points[a] - inside) < 0.0f)
+	{
+		std::swap(face.vertices[1], face.vertices[2]);
+		face.normal = -face.normal;
+	}
+
+	face.offset = glm::dot(face.normal, points[a]);
+	buildFaces.push_back(face);
+}
+
+void QuickHull::assignPoints(const std::vector<glm::vec3>& points, const std::vector<unsigned>& candidates, unsigned firstFace, float tolerance)
+{
+	for (auto & point : candidates)
+	{
+		for (unsigned i = firstFace; i < buildFaces.size(); i++)
+		{
+			if (glm::dot(buildFaces[i].normal, points[point]) - buildFaces[i].offset > tolerance)
+			{
+				buildFaces[i].outside.push_back(point);
+				break;
+			}
+		}
+	}
+}
+
+std::vector<unsigned> QuickHull::collectResult(const std::vector<glm::vec3>& points)
+{
+	std::unordered_map<unsigned, unsigned> vertexIndices;
+	// input point of every vertex of the result
+	std::vector<unsigned> sourcePoints;
+	// face on the left side of directed edge, edges are keyed by indices of result vertices
+	std::unordered_map<unsigned long long, unsigned> edgeFaces;
+
+	for (auto & buildFace : buildFaces)
+	{
+		if (buildFace.removed)
+			continue;
+
+		QuickHullFace face;
+		face.normal = buildFace.normal;
+
+		for (int i = 0; i < 3; i++)
+		{
+			auto it = vertexIndices.find(buildFace.vertices[i]);
+			if (it == vertexIndices.end())
+			{
+				it = vertexIndices.insert({ buildFace.vertices[i], (unsigned)vertices.size() }).first;
+				vertices.push_back(points[buildFace.vertices[i]]);
+				sourcePoints.push_back(buildFace.vertices[i]);
+			}
+			face.vertices[i] = it->second;
+		}
+
+		faces.push_back(face);
+	}
+
+	unsigned long long vertexCount = vertices.size();
+	for (unsigned i = 0; i < faces.size(); i++)
+		for (int j = 0; j < 3; j++)
+			edgeFaces[faces[i].vertices[j] * vertexCount + faces[i].vertices[(j + 1) % 3]] = i;
+
+	// nearly coplanar neighbours get normal of the first face of their group, so that hull merges them
+	std::vector<bool> grouped(faces.size(), false);
+
+	for (unsigned first = 0; first < faces.size(); first++)
+	{
+		if (grouped[first])
+			continue;
+
+		grouped[first] = true;
+		std::vector<unsigned> group = { first };
+
+		for (unsigned i = 0; i < group.size(); i++)
+		{
+			const QuickHullFace& face = faces[group[i]];
+
+			for (int j = 0; j < 3; j++)
+			{
+				unsigned neighbour = edgeFaces[face.vertices[(j + 1) % 3] * vertexCount + face.vertices[j]];
+
+				if (!grouped[neighbour] && glm::dot(faces[neighbour].normal, faces[first].normal) > QUICK_HULL_COPLANAR_COSINE)
+				{
+					grouped[neighbour] = true;
+					faces[neighbour].normal = faces[first].normal;
+					group.push_back(neighbour);
+				}
+			}
+		}
+	}
+
+	// vertex whose faces are all in one group lies inside flat face
+	std::vector<bool> interior(vertices.size(), true);
+	std::vector<const glm::vec3*> vertexNormals(vertices.size(), NULL);
+
+	for (auto & face : faces)
+	{
+		for (auto & vertex : face.vertices)
+		{
+			if (vertexNormals[vertex] == NULL)
+				vertexNormals[vertex] = &face.normal;
+			else if (*vertexNormals[vertex] != face.normal)
+				interior[vertex] = false;
+		}
+	}
+
+	std::vector<unsigned> interiorPoints;
+	for (unsigned i = 0; i < vertices.size(); i++)
+	{
+		if (interior[i])
+			interiorPoints.push_back(sourcePoints[i]);
+	}
+
+	return interiorPoints;
+}
@@ -0,0 +1,89 @@
+/**
+ * Bakalarska praca - Simualace pevnych teles
+ * VUT FIT, 2018/2019
+ *
+ * Autor:	Denis Leitner, xleitn02
+ * Subor:	QuickHull.h
+ *
+ */
+
+#pragma once
+
+#ifndef QUICK_HULL_H
+#define QUICK_HULL_H
+
+#include <glm/glm.hpp>
+#include <vector>
+
+// distance under which point is considered lying on face, relative to size of point set
+constexpr float QUICK_HULL_TOLERANCE = 0.00001f;
+// cosine of angle under which neighbouring faces of result are considered coplanar
+constexpr float QUICK_HULL_COPLANAR_COSINE = 0.9999f;
+
+/**
+ * @brief Triangle of convex hull, vertices are in counter-clockwise order seen from outside
+ */
+struct QuickHullFace
+{
+	unsigned vertices[3];	// indices into vertices of the hull
+	glm::vec3 normal;		// outer normal, coplanar neighbours share the same one
+};
+
+/**
+ * @brief Builds convex hull of point set by quickhull, the farthest point is added first,
+ *        so hull stopped at vertex budget is simplified shape that covers the points as well as possible
+ */
+class QuickHull
+{
+public:
+	std::vector<glm::vec3> vertices;
+	std::vector<QuickHullFace> faces;
+
+	/**
+	 * @brief Builds hull of points
+	 * @param points Points of which to build hull
+	 * @param maxVertices Upper limit of vertices of the hull, 0 for no limit
+	 * @return Whether hull was built, false if points are flat or there are less than 4 of them
+	 */
+	bool build(const std::vector<glm::vec3>& points, unsigned maxVertices);
+
+private:
+	/**
+	 * @brief Face of hull during build
+	 */
+	struct BuildFace
+	{
+		unsigned vertices[3];			// indices into input points
+		glm::vec3 normal;
+		float offset;					// dot product of normal and any point of the face
+		std::vector<unsigned> outside;	// points above the face not assigned to other face
+		bool removed;					// whether face was replaced by faces of added point
+	};
+
+	std::vector<BuildFace> buildFaces;
+
+	/**
+	 * @brief Builds faces of hull by adding the farthest point outside until budget is reached
+	 * @return Whether hull was built, false if points are flat
+	 */
+	bool expand(const std::vector<glm::vec3>& points, unsigned maxVertices);
+
+	/**
+	 * @brief Creates face with normal oriented away from given inner point
+	 */
+	void createFace(const std::vector<glm::vec3>& points, unsigned a, unsigned b, unsigned c, const glm::vec3& inside);
+
+	/**
+	 * @brief Assigns points to the first of given faces they lie above, points below all of them are inside hull
+	 * @param firstFace Index of the first face to which points can be assigned, later faces follow it
+	 */
+	void assignPoints(const std::vector<glm::vec3>& points, const std::vector<unsigned>& candidates, unsigned firstFace, float tolerance);
+
+	/**
+	 * @brief Copies faces that weren't removed into result and gives coplanar neighbours the same normal
+	 * @return Indices of points that are vertices inside flat faces of the result
+	 */
+	std::vector<unsigned> collectResult(const std::vector<glm::vec3>& points);
+};
+
+#endif
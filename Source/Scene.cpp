@@ -1,186 +1,666 @@
-/**
- * Bakalarska praca - Simualace pevnych teles
- * VUT FIT, 2018/2019
- *
- * Autor:	Denis Leitner, xleitn02
- * Subor:	Scene.cpp
- *
- */
-
-#include "Scene.h"
-
-Scene::Scene()
-{
-	camera = Camera(glm::vec3(0.0f, 2.0f, 20.0f));
-	modelManager = ModelManager();
-}
-
-
-Scene::~Scene()
-{
-	for (auto it = objects.begin(); it != objects.end(); it++)
-	{
-		delete *it;
-	}
-	objects.clear();
-}
-
-bool Scene::loadScene(fs::path filename)
-{
-	bool rtrnVal = true;
-
-	std::ifstream file;
-	file.open(filename);
-
-	auto fillVector = [](glm::vec3& vector, std::string& line)
-	{
-		std::stringstream stream;
-		stream << line;
-		stream >> vector.x; stream >> vector.y; stream >> vector.z;
-	};
-
-	if (file.is_open())
-	{
-		// line read from file
-		std::string line;
-
-		// read file
-		while (file)
-		{
-			try
-			{
-				std::getline(file, line);
-
-				if (line.length() < 2)
-					continue;
-
-				std::string lineHeader = line.substr(0, 2);
-				std::stringstream stream;
-
-				stream << line.substr(2);
-
-				if (lineHeader == "m ")
-				{
-					// model to be loaded from file
-					char modelType;
-					float radius = 0.0f;
-					std::string modelName;
-					std::string modelPath;
-					ShapeType type = none;
-
-					stream >> modelType;
-					stream >> modelName;
-					stream >> modelPath;
-
-					switch (modelType)
-					{
-					case 's':
-						type = sphere;
-						stream >> radius;
-						break;
-					case 'h':
-						type = hull;
-						break;
-					case 'p':
-						type = plane;
-						break;
-					}
-
-					if (type == none)
-					{
-						rtrnVal = false;
-						break;
-					}
-
-					fs::path pathToModel = std::filesystem::u8path(ROOT_DIR);
-					fs::path model = std::filesystem::path(modelPath);
-					pathToModel += model;
-
-					if (!modelManager.loadModel(pathToModel, modelName, type, radius))
-					{
-						rtrnVal = false;
-						break;
-					}
-				}
-				else if (lineHeader == "o ")
-				{
-					// object to be created in scene
-
-					Object::ObjectInit object;
-					std::string modelName;
-					std::string objectDensity;
-					stream >> object.objectName; stream >> modelName; stream >> objectDensity;
-
-					if (objectDensity == "INFINITY")
-						object.density = INFINITY;
-					else
-					{
-						object.density = std::stof(objectDensity);
-					}
-
-					if (object.density <= 0.0f)
-					{
-						std::cout << "Density of an object must be greater than 0" << std::endl;
-						rtrnVal = false;
-						break;
-					}
-
-					// object color
-					std::getline(file, line);
-					fillVector(object.color, line);
-
-					// object position
-					std::getline(file, line);
-					fillVector(object.position, line);
-
-					// object rotation
-					std::getline(file, line);
-					fillVector(object.rotation, line);
-
-					// velocity vector of an object
-					std::getline(file, line);
-					fillVector(object.initialVelocity, line);
-
-					object.model = modelManager.getModel(modelName);
-
-					if (object.model == NULL)
-					{
-						std::cout << "Model requested for object " << object.objectName << " not found" << std::endl;
-						rtrnVal = false;
-						break;
-					}
-					Object *obj;
-					try
-					{
-						obj = new Object(object);
-					}
-					catch (const std::bad_alloc &ba)
-					{
-						std::cout << "Couldn't allocate memory: " << ba.what() << std::endl;
-						rtrnVal = false;
-						break;
-					}
-					objects.push_back(obj);
-				}
-			}
-			catch (...)
-			{
-				std::cout << "Wrong format of scene file" << std::endl;
-				rtrnVal = false;
-				break;
-			}
-		}
-		file.close();
-	}
-	else
-	{
-		std::cout << "Couldn't open file " << filename << std::endl;
-		rtrnVal = false;
-	}
-	return rtrnVal;
-}
-
-Camera* Scene::getCamera()
-{
-	return &camera;
-}
+/**
+ * Bakalarska praca - Simualace pevnych teles
+ * VUT FIT, 2018/2019
+ *
+ * Autor:	Denis Leitner, xleitn02
+ * Subor:	Scene.cpp
+ *
+ */
+
+#include "Scene.h"
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+
+Scene::Scene()
+{
+	camera = Camera(glm::vec3(0.0f, 2.0f, 20.0f));
+	modelManager = ModelManager();
+}
+
+
+Scene::~Scene()
+{
+	for (auto it = objects.begin(); it != objects.end(); it++)
+	{
+		delete *it;
+	}
+	objects.clear();
+}
+
+/**
+ * @brief Skips spaces and tabs
+ * @return First character of the next token or end of the line
+ */
+static const char* skipSpaces(const char* first, const char* last)
+{
+	while (first != last && (*first == ' ' || *first == '\t'))
+		first++;
+	return first;
+}
+
+/**
+ * @brief Reads token separated by spaces or tabs
+ * @param[in,out] first Position in the line, moved behind the token
+ * @param last End of the line
+ * @return Token, empty at the end of the line
+ */
+static std::string_view readToken(const char*& first, const char* last)
+{
+	first = skipSpaces(first, last);
+	const char* start = first;
+
+	while (first != last && *first != ' ' && *first != '\t')
+		first++;
+
+	return std::string_view(start, first - start);
+}
+
+/**
+ * @brief Reads number in place, "INFINITY" is read as infinity
+ * @param[in,out] first Position in the line, moved behind the number
+ * @param last End of the line
+ * @param[out] value Read number
+ * @return Whether number was read
+ */
+static bool readFloat(const char*& first, const char* last, float& value)
+{
+	first = skipSpaces(first, last);
+
+	// from_chars doesn't accept explicit plus sign
+	if (first != last && *first == '+')
+		first++;
+
+	std::from_chars_result result = std::from_chars(first, last, value);
+	if (result.ec != std::errc())
+		return false;
+
+	first = result.ptr;
+	return true;
+}
+
+/**
+ * @brief Reads 3 numbers at the beginning of the line, rest of the line is description of the vector
+ */
+static bool readVector(std::string_view line, glm::vec3& vector)
+{
+	const char* first = line.data();
+	const char* last = line.data() + line.size();
+
+	return readFloat(first, last, vector.x) && readFloat(first, last, vector.y) && readFloat(first, last, vector.z);
+}
+
+/**
+ * @brief Gets path of model file given in scene file, which is relative to root directory
+ */
+static fs::path getModelPath(const std::string& modelPath)
+{
+	fs::path pathToModel = std::filesystem::u8path(ROOT_DIR);
+	pathToModel += std::filesystem::path(modelPath);
+	return pathToModel;
+}
+
+bool Scene::loadScene(fs::path filename, ThreadPool* threadPool)
+{
+	MappedFile file;
+
+	if (!file.open(filename))
+	{
+		std::cout << "Couldn't open file " << filename << std::endl;
+		return false;
+	}
+
+	if (file.getSize() >= sizeof(SCENE_FILE_MAGIC) && std::equal(SCENE_FILE_MAGIC, SCENE_FILE_MAGIC + sizeof(SCENE_FILE_MAGIC), file.getData()))
+		return loadBinaryScene(file, filename, threadPool);
+
+	return loadTextScene(file, threadPool);
+}
+
+bool Scene::loadTextScene(const MappedFile& file, ThreadPool* threadPool)
+{
+	// lines of one "o" record, header line is followed by color, position, rotation and velocity
+	struct ObjectText
+	{
+		std::string_view lines[5];
+		unsigned lineNumber;
+	};
+
+	const char* position = file.getData();
+	const char* end = position + file.getSize();
+	unsigned lineNumber = 0;
+
+	// reads next line without line break, returns false at the end of the file
+	auto nextLine = [&position, end, &lineNumber](std::string_view& line)
+	{
+		if (position == end)
+			return false;
+
+		const char* lineEnd = static_cast<const char*>(std::memchr(position, '\n', end - position));
+		if (lineEnd == NULL)
+			lineEnd = end;
+
+		line = std::string_view(position, lineEnd - position);
+		if (!line.empty() && line.back() == '\r')
+			line.remove_suffix(1);
+
+		position = lineEnd == end ? end : lineEnd + 1;
+		lineNumber++;
+		return true;
+	};
+
+	std::vector<ObjectText> objectTexts;
+	// errors with numbers of lines they belong to, they are printed in order of lines
+	std::vector<std::pair<unsigned, std::string>> errors;
+	std::string_view line;
+
+	// models must be loaded before objects are parsed, they are few and are loaded in order
+	while (nextLine(line))
+	{
+		if (line.length() < 2)
+			continue;
+
+		std::string_view lineHeader = line.substr(0, 2);
+
+		if (lineHeader == "m " || lineHeader == "c ")
+		{
+			if (!loadModelDefinition(std::string(line)))
+				errors.emplace_back(lineNumber, "model definition couldn't be loaded");
+		}
+		else if (lineHeader == "o ")
+		{
+			ObjectText object;
+			object.lines[0] = line;
+			object.lineNumber = lineNumber;
+
+			bool complete = true;
+			for (int i = 1; i < 5 && complete; i++)
+				complete = nextLine(object.lines[i]);
+
+			if (!complete)
+			{
+				errors.emplace_back(object.lineNumber, "object record is incomplete");
+				break;
+			}
+
+			objectTexts.push_back(object);
+		}
+	}
+
+	// line of error of every object, the header line unless one of lines of vectors is wrong
+	std::vector<unsigned> errorLines(objectTexts.size());
+
+	auto readObject = [this, &objectTexts, &errorLines](unsigned index, Object::ObjectInit& object, std::string& error)
+	{
+		const ObjectText& text = objectTexts[index];
+		errorLines[index] = text.lineNumber;
+		const char* first = text.lines[0].data() + 2;
+		const char* last = text.lines[0].data() + text.lines[0].size();
+
+		std::string_view name = readToken(first, last);
+		std::string_view modelName = readToken(first, last);
+
+		if (name.empty() || modelName.empty() || !readFloat(first, last, object.density))
+		{
+			error = "expected \"o <name> <model> <density>\"";
+			return false;
+		}
+
+		object.objectName = std::string(name);
+		object.model = modelManager.getModel(std::string(modelName));
+
+		if (object.model == NULL)
+		{
+			error = "model " + std::string(modelName) + " requested for object " + object.objectName + " not found";
+			return false;
+		}
+
+		glm::vec3 rotation;
+		glm::vec3* vectors[4] = { &object.color, &object.position, &rotation, &object.initialVelocity };
+		const char* descriptions[4] = { "color", "position", "rotation", "velocity vector" };
+
+		for (int i = 0; i < 4; i++)
+		{
+			if (!readVector(text.lines[i + 1], *vectors[i]))
+			{
+				error = "expected 3 numbers of " + std::string(descriptions[i]) + " of object " + object.objectName;
+				errorLines[index] = text.lineNumber + i + 1;
+				return false;
+			}
+		}
+
+		object.rotation = Object::constructRotationMatrix(rotation);
+
+		return true;
+	};
+
+	// objects are parsed even after errors of models, so that all errors are reported at once
+	std::vector<std::string> objectErrors;
+	bool created = createObjects(objectTexts.size(), readObject, threadPool, objectErrors);
+
+	for (unsigned i = 0; i < objectErrors.size(); i++)
+	{
+		if (!objectErrors[i].empty())
+			errors.emplace_back(errorLines[i], objectErrors[i]);
+	}
+
+	if (!errors.empty())
+	{
+		std::stable_sort(errors.begin(), errors.end(),
+			[](const std::pair<unsigned, std::string>& a, const std::pair<unsigned, std::string>& b) { return a.first < b.first; });
+
+		std::vector<std::string> messages;
+		for (auto & error : errors)
+			messages.push_back("Line " + std::to_string(error.first) + ": " + error.second);
+
+		printErrors(messages);
+		return false;
+	}
+
+	return created;
+}
+
+bool Scene::loadBinaryScene(const MappedFile& file, const fs::path& filename, ThreadPool* threadPool)
+{
+	const char* data = file.getData();
+	size_t size = file.getSize();
+	SceneFileHeader header;
+
+	if (size < sizeof(header))
+	{
+		std::cout << "Binary scene file " << filename << " is truncated" << std::endl;
+		return false;
+	}
+
+	std::memcpy(&header, data, sizeof(header));
+
+	if (header.version != SCENE_FILE_VERSION)
+	{
+		std::cout << "Binary scene file " << filename << " has unsupported version " << header.version << std::endl;
+		return false;
+	}
+
+	size_t definitionsOffset = alignSceneOffset(sizeof(header));
+	size_t recordsOffset = alignSceneOffset(definitionsOffset + header.definitionsSize);
+	size_t namesOffset = recordsOffset + (size_t)header.objectCount * sizeof(SceneObjectRecord);
+
+	if (namesOffset + header.namesSize > size)
+	{
+		std::cout << "Binary scene file " << filename << " is truncated" << std::endl;
+		return false;
+	}
+
+	// models are few, they are loaded from the same lines as in text scene
+	std::stringstream definitions(std::string(data + definitionsOffset, header.definitionsSize));
+	std::string line;
+
+	while (std::getline(definitions, line))
+	{
+		if (!loadModelDefinition(line))
+			return false;
+	}
+
+	// records are aligned in the mapped file, they are used in place
+	const SceneObjectRecord* records = reinterpret_cast<const SceneObjectRecord*>(data + recordsOffset);
+	const char* names = data + namesOffset;
+
+	auto readObject = [this, records, names, &header](unsigned index, Object::ObjectInit& object, std::string& error)
+	{
+		const SceneObjectRecord& record = records[index];
+
+		if (record.model >= modelManager.models.size() || (size_t)record.nameOffset + record.nameLength > header.namesSize)
+		{
+			error = "model or name is out of range";
+			return false;
+		}
+
+		object.objectName.assign(names + record.nameOffset, record.nameLength);
+		object.model = modelManager.models[record.model];
+		object.density = record.density;
+		object.color = glm::vec3(record.color[0], record.color[1], record.color[2]);
+		object.position = glm::vec3(record.position[0], record.position[1], record.position[2]);
+		object.initialVelocity = glm::vec3(record.velocity[0], record.velocity[1], record.velocity[2]);
+
+		for (int i = 0; i < 3; i++)
+			object.rotation[i] = glm::vec3(record.rotation[3 * i], record.rotation[3 * i + 1], record.rotation[3 * i + 2]);
+
+		return true;
+	};
+
+	std::vector<std::string> objectErrors;
+
+	if (!createObjects(header.objectCount, readObject, threadPool, objectErrors))
+	{
+		std::vector<std::string> errors;
+
+		for (unsigned i = 0; i < objectErrors.size(); i++)
+		{
+			if (!objectErrors[i].empty())
+				errors.push_back("Object record " + std::to_string(i) + ": " + objectErrors[i]);
+		}
+
+		printErrors(errors);
+		return false;
+	}
+
+	return true;
+}
+
+bool Scene::saveBinaryScene(fs::path filename)
+{
+	// models are defined by "m" lines first, children of compounds may be defined after the compound
+	std::string definitions;
+	std::unordered_map<const Model*, uint32_t> modelIndices;
+
+	for (auto & model : modelManager.models)
+	{
+		modelIndices.emplace(model, (uint32_t)modelIndices.size());
+		definitions += model->definition + '\n';
+	}
+
+	for (auto & model : modelManager.models)
+		definitions += model->childDefinitions;
+
+	// records are built from current state of objects, scene keeps no copy of the file it was loaded from
+	std::vector<SceneObjectRecord> records(objects.size());
+	std::string names;
+
+	for (unsigned i = 0; i < objects.size(); i++)
+	{
+		const Object* object = objects[i];
+		SceneObjectRecord& record = records[i];
+		const glm::mat3& rotation = object->configuration.rotation;
+
+		record.model = modelIndices[object->model];
+		record.nameOffset = names.size();
+		record.nameLength = object->objectName.size();
+		record.density = object->density;
+
+		for (int j = 0; j < 3; j++)
+		{
+			record.color[j] = object->color[j];
+			record.position[j] = object->configuration.position[j];
+			record.velocity[j] = object->configuration.velocityVector[j];
+
+			for (int k = 0; k < 3; k++)
+				record.rotation[3 * j + k] = rotation[j][k];
+		}
+
+		names += object->objectName;
+	}
+
+	std::ofstream file(filename, std::ios::binary);
+
+	if (!file.is_open())
+	{
+		std::cout << "Couldn't open file " << filename << std::endl;
+		return false;
+	}
+
+	SceneFileHeader header;
+	std::memcpy(header.magic, SCENE_FILE_MAGIC, sizeof(header.magic));
+	header.version = SCENE_FILE_VERSION;
+	header.definitionsSize = definitions.size();
+	header.objectCount = records.size();
+	header.namesSize = names.size();
+
+	const char padding[4] = {};
+	size_t definitionsOffset = alignSceneOffset(sizeof(header));
+	size_t definitionsEnd = definitionsOffset + definitions.size();
+
+	file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	file.write(padding, definitionsOffset - sizeof(header));
+	file.write(definitions.data(), definitions.size());
+	file.write(padding, alignSceneOffset(definitionsEnd) - definitionsEnd);
+	file.write(reinterpret_cast<const char*>(records.data()), records.size() * sizeof(SceneObjectRecord));
+	file.write(names.data(), names.size());
+
+	if (!file)
+	{
+		std::cout << "Couldn't write file " << filename << std::endl;
+		return false;
+	}
+
+	return true;
+}
+
+bool Scene::isBinarySceneCurrent(const fs::path& binaryFilename, const fs::path& textFilename)
+{
+	std::error_code textError, binaryError;
+	auto textTime = fs::last_write_time(textFilename, textError);
+	auto binaryTime = fs::last_write_time(binaryFilename, binaryError);
+
+	if (binaryError || (!textError && binaryTime < textTime))
+		return false;
+
+	MappedFile file;
+	SceneFileHeader header;
+
+	if (!file.open(binaryFilename) || file.getSize() < sizeof(header))
+		return false;
+
+	std::memcpy(&header, file.getData(), sizeof(header));
+	size_t definitionsOffset = alignSceneOffset(sizeof(header));
+
+	// file of another version is converted again
+	if (!std::equal(SCENE_FILE_MAGIC, SCENE_FILE_MAGIC + sizeof(SCENE_FILE_MAGIC), header.magic) || header.version != SCENE_FILE_VERSION
+		|| definitionsOffset + header.definitionsSize > file.getSize())
+		return false;
+
+	// model files are given by "m" lines of definitions, binary scene is stale if any of them changed since
+	std::stringstream definitions(std::string(file.getData() + definitionsOffset, header.definitionsSize));
+	std::string line;
+
+	while (std::getline(definitions, line))
+	{
+		std::stringstream stream(line);
+		std::string lineHeader, modelType, modelName, modelPath;
+
+		if (!(stream >> lineHeader >> modelType >> modelName) || lineHeader != "m" || modelType == "c" || !(stream >> modelPath))
+			continue;
+
+		std::error_code modelError;
+		auto modelTime = fs::last_write_time(getModelPath(modelPath), modelError);
+
+		if (!modelError && binaryTime < modelTime)
+			return false;
+	}
+
+	return true;
+}
+
+bool Scene::loadModelDefinition(const std::string& line)
+{
+	std::string lineHeader = line.substr(0, 2);
+	std::stringstream stream;
+
+	stream << line.substr(2);
+
+	if (lineHeader == "c ")
+	{
+		// child of compound model, position and rotation in local space of the compound
+		std::string compoundName;
+		std::string childName;
+		glm::vec3 position;
+		glm::vec3 rotation;
+
+		stream >> compoundName; stream >> childName;
+		stream >> position.x; stream >> position.y; stream >> position.z;
+		stream >> rotation.x; stream >> rotation.y; stream >> rotation.z;
+
+		if (stream.fail() || !modelManager.addCompoundChild(compoundName, childName, position, rotation))
+			return false;
+
+		modelManager.getModel(compoundName)->childDefinitions += line + '\n';
+		return true;
+	}
+
+	if (lineHeader != "m ")
+		return false;
+
+	// model to be loaded from file
+	char modelType;
+	float radius = 0.0f;
+	std::string modelName;
+	std::string modelPath;
+	std::string option;
+	ShapeType type = none;
+
+	stream >> modelType;
+	stream >> modelName;
+
+	if (modelType == 'c')
+	{
+		// compound has no file, its children are added by "c" lines
+		if (!modelManager.createCompound(modelName))
+			return false;
+
+		modelManager.models.back()->definition = line;
+		return true;
+	}
+
+	stream >> modelPath;
+
+	switch (modelType)
+	{
+	case 's':
+		type = sphere;
+		stream >> radius;
+		break;
+	case 'h':
+		type = hull;
+		break;
+	case 'p':
+		type = plane;
+		break;
+	case 'g':
+		type = halfSpace;
+		break;
+	case 't':
+		type = mesh;
+		break;
+	}
+
+	if (type == none)
+		return false;
+
+	// optional "tight" after model path, AABBs of hull objects are found from extreme vertices,
+	// optional "bounded" limits half-space to its model,
+	// optional "vertices <n>" or "faces <n>" replaces hull by its convex hull simplified to given budget
+	bool tightBounds = false;
+	bool bounded = false;
+	unsigned proxyVertices = 0;
+
+	while (stream >> option)
+	{
+		unsigned budget = 0;
+
+		if (option == "tight")
+			tightBounds = true;
+		else if (option == "bounded")
+			bounded = true;
+		else if (option == "vertices" && stream >> budget && budget >= 4)
+			proxyVertices = budget;
+		else if (option == "faces" && stream >> budget && budget >= 4)
+			// triangulated hull of n vertices has 2n - 4 triangles, coplanar ones are merged
+			proxyVertices = budget / 2 + 2;
+		else
+		{
+			std::cout << "Unknown option \"" << option << "\" of model " << modelName << std::endl;
+			return false;
+		}
+	}
+
+	if (!modelManager.loadModel(getModelPath(modelPath), modelName, type, radius, tightBounds, bounded, proxyVertices))
+		return false;
+
+	modelManager.models.back()->definition = line;
+	return true;
+}
+
+bool Scene::checkObject(const Object::ObjectInit& object, std::string& error)
+{
+	if (!(object.density > 0.0f))
+	{
+		error = "density of object " + object.objectName + " must be greater than 0";
+		return false;
+	}
+
+	if ((object.model->shape->type == halfSpace || object.model->shape->type == mesh) && object.density != INFINITY)
+	{
+		error = "half-space or mesh object " + object.objectName + " must have infinite density";
+		return false;
+	}
+
+	if (object.model->shape->type == compound && static_cast<Compound*>(object.model->shape)->children.empty())
+	{
+		error = "compound model of object " + object.objectName + " has no children";
+		return false;
+	}
+
+	return true;
+}
+
+bool Scene::createObjects(unsigned count, const ObjectReader& readObject, ThreadPool* threadPool, std::vector<std::string>& errors)
+{
+	std::vector<Object::ObjectInit> initValues(count);
+	std::vector<Object*> created(count, NULL);
+	errors.assign(count, std::string());
+
+	// objects only read their models, so they can be created by several threads at once
+	auto createRange = [&](unsigned begin, unsigned end, unsigned /*thread*/)
+	{
+		for (unsigned i = begin; i < end; i++)
+		{
+			if (!readObject(i, initValues[i], errors[i]) || !checkObject(initValues[i], errors[i]))
+				continue;
+
+			try
+			{
+				created[i] = new Object(initValues[i]);
+			}
+			catch (const std::bad_alloc &ba)
+			{
+				errors[i] = std::string("couldn't allocate memory: ") + ba.what();
+			}
+		}
+	};
+
+	if (threadPool != NULL)
+		threadPool->parallelFor(count, createRange);
+	else
+		createRange(0, count, 0);
+
+	bool valid = true;
+	for (unsigned i = 0; i < count; i++)
+		valid = valid && created[i] != NULL;
+
+	if (!valid)
+	{
+		for (auto & object : created)
+			delete object;
+		return false;
+	}
+
+	objects.insert(objects.end(), created.begin(), created.end());
+
+	return true;
+}
+
+void Scene::printErrors(const std::vector<std::string>& errors)
+{
+	std::cout << "Wrong format of scene file, " << errors.size() << (errors.size() == 1 ? " error" : " errors") << ":" << std::endl;
+
+	for (unsigned i = 0; i < errors.size() && i < MAX_REPORTED_SCENE_ERRORS; i++)
+		std::cout << errors[i] << std::endl;
+
+	if (errors.size() > MAX_REPORTED_SCENE_ERRORS)
+		std::cout << "... and " << errors.size() - MAX_REPORTED_SCENE_ERRORS << " more" << std::endl;
+}
+
+Camera* Scene::getCamera()
+{
+	return &camera;
+}
@@ -1,53 +1,134 @@
-/**
- * Bakalarska praca - Simualace pevnych teles
- * VUT FIT, 2018/2019
- *
- * Autor:	Denis Leitner, xleitn02
- * Subor:	Scene.h
- *
- */
-
-#pragma once
-
-#ifndef SCENE_H
-#define SCENE_H
-
-#include <vector>
-
-#include "Object.h"
-#include "Camera.h"
-#include "ModelManager.h"
-
-class Scene
-{
-public:
-	// Objects of the scene
-	std::vector <Object*> objects;
-	// Model manager of the scene
-	ModelManager modelManager;
-
-	/**
-	 * @brief Constructor, initializes mainCamera and modelManager
-	 */
-	Scene();
-
-	/**
-	 * @brief Destructor, deletes all objects
-	 */
-	~Scene();
-
-	/**
-	 * @brief			Loads scene data from file and creates scene
-	 * @param filename	File from which to load scene
-	 * @return			Returns true if everything succeeded, false if something failed
-	 */
-	bool loadScene(fs::path filename);
-
-	Camera* getCamera();
-
-private:
-	// Main Camera of the scene
-	Camera camera;
-};
-
+/**
+ * Bakalarska praca - Simualace pevnych teles
+ * VUT FIT, 2018/2019
+ *
+ * Autor:	Denis Leitner, xleitn02
+ * Subor:	Scene.h
+ *
+ */
+
+#pragma once
+
+#ifndef SCENE_H
+#define SCENE_H
+
+#include <functional>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "Object.h"
+#include "Camera.h"
+#include "ModelManager.h"
+#include "SceneFile.h"
+#include "ThreadPool.h"
+
+// errors of scene file printed at most, the rest is only counted
+constexpr unsigned MAX_REPORTED_SCENE_ERRORS = 20;
+
+class Scene
+{
+public:
+	// Objects of the scene
+	std::vector <Object*> objects;
+	// Model manager of the scene
+	ModelManager modelManager;
+
+	/**
+	 * @brief Constructor, initializes mainCamera and modelManager
+	 */
+	Scene();
+
+	/**
+	 * @brief Destructor, deletes all objects
+	 */
+	~Scene();
+
+	/**
+	 * @brief			Loads scene data from file and creates scene, binary scene files are recognised by their first bytes
+	 * @param filename	File from which to load scene
+	 * @param threadPool	Threads that parse and create objects in parallel, NULL to create them by the calling thread
+	 * @return			Returns true if everything succeeded, false if something failed
+	 */
+	bool loadScene(fs::path filename, ThreadPool* threadPool = NULL);
+
+	/**
+	 * @brief			Saves scene in binary format, models are saved by lines that defined them,
+	 *					objects in their current position, rotation and velocity
+	 * @param filename	File into which to save scene
+	 * @return			Returns true if everything succeeded, false if something failed
+	 */
+	bool saveBinaryScene(fs::path filename);
+
+	/**
+	 * @brief			Checks whether binary scene is newer than text scene it was converted from and than all model files it uses
+	 * @param binaryFilename	Binary scene file
+	 * @param textFilename	Text scene file, binary scene is current if it doesn't exist
+	 * @return			Returns true if binary scene can be loaded instead of the text one
+	 */
+	static bool isBinarySceneCurrent(const fs::path& binaryFilename, const fs::path& textFilename);
+
+	Camera* getCamera();
+
+private:
+	// Main Camera of the scene
+	Camera camera;
+
+	/**
+	 * @brief Fills initial values of object with given index, returns false and sets error message if they are invalid
+	 */
+	typedef std::function<bool(unsigned index, Object::ObjectInit& object, std::string& error)> ObjectReader;
+
+	/**
+	 * @brief			Loads scene from memory-mapped text file; lines of models are processed in order,
+	 *					object records are split by lines and parsed in parallel chunks
+	 * @param file		Mapped text scene file
+	 * @param threadPool	Threads that parse and create objects, may be NULL
+	 * @return			Returns true if everything succeeded, false if something failed, errors are printed with line numbers
+	 */
+	bool loadTextScene(const MappedFile& file, ThreadPool* threadPool);
+
+	/**
+	 * @brief			Loads scene from memory-mapped binary file, models are loaded from their definitions
+	 *					and objects are created from packed records without parsing
+	 * @param file		Mapped binary scene file
+	 * @param filename	Name of the file used in error messages
+	 * @param threadPool	Threads that create objects, may be NULL
+	 * @return			Returns true if everything succeeded, false if something failed
+	 */
+	bool loadBinaryScene(const MappedFile& file, const fs::path& filename, ThreadPool* threadPool);
+
+	/**
+	 * @brief			Loads model of "m" line or adds child of "c" line of text scene
+	 * @param line		Whole line including its header
+	 * @return			Returns true on success, false on wrong format or if model couldn't be loaded
+	 */
+	bool loadModelDefinition(const std::string& line);
+
+	/**
+	 * @brief			Checks whether attributes of an object are valid
+	 * @param object	Initial values of the object, model must be set
+	 * @param[out] error	Reason why the object is invalid
+	 * @return			Returns true for valid object
+	 */
+	bool checkObject(const Object::ObjectInit& object, std::string& error);
+
+	/**
+	 * @brief			Reads, checks and creates objects in parallel chunks, objects are added to the scene in order of indices
+	 *					only if all of them are valid
+	 * @param count		Number of objects
+	 * @param readObject	Reads initial values of an object, called from several threads at once
+	 * @param threadPool	Threads that create objects, may be NULL
+	 * @param[out] errors	Error message of every object, empty for valid objects
+	 * @return			Returns true if all objects were created
+	 */
+	bool createObjects(unsigned count, const ObjectReader& readObject, ThreadPool* threadPool, std::vector<std::string>& errors);
+
+	/**
+	 * @brief			Prints errors of scene file, at most MAX_REPORTED_SCENE_ERRORS of them
+	 * @param errors	Messages including their location in the file
+	 */
+	void printErrors(const std::vector<std::string>& errors);
+};
+
 #endif
\ No newline at end of file
@@ -0,0 +1,116 @@
+/**
+ * Bakalarska praca - Simualace pevnych teles
+ * VUT FIT, 2018/2019
+ *
+ * Autor:	Denis Leitner, xleitn02
+ * Subor:	SceneFile.cpp
+ *
+ */
+
+#include "SceneFile.h"
+#include <fstream>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+
+MappedFile::MappedFile()
+{
+	data = NULL;
+	size = 0;
+	allocated = false;
+}
+
+MappedFile::~MappedFile()
+{
+	close();
+}
+
+bool MappedFile::open(const fs::path& filename)
+{
+	close();
+
+#ifndef _WIN32
+	int descriptor = ::open(filename.c_str(), O_RDONLY);
+	if (descriptor < 0)
+		return false;
+
+	struct stat status;
+	if (fstat(descriptor, &status) != 0)
+	{
+		::close(descriptor);
+		return false;
+	}
+
+	if (status.st_size == 0)
+	{
+		// empty file can't be mapped, it has no data
+		::close(descriptor);
+		return true;
+	}
+
+	void* mapping = mmap(NULL, status.st_size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+	// mapping stays valid after the descriptor is closed
+	::close(descriptor);
+
+	if (mapping == MAP_FAILED)
+		return false;
+
+	data = static_cast<const char*>(mapping);
+	size = status.st_size;
+#else
+	std::ifstream file(filename, std::ios::binary | std::ios::ate);
+	if (!file.is_open())
+		return false;
+
+	size_t fileSize = file.tellg();
+	if (fileSize == 0)
+		return true;
+
+	char* buffer = new char[fileSize];
+	file.seekg(0);
+
+	if (!file.read(buffer, fileSize))
+	{
+		delete[] buffer;
+		return false;
+	}
+
+	data = buffer;
+	size = fileSize;
+	allocated = true;
+#endif
+
+	return true;
+}
+
+void MappedFile::close()
+{
+	if (data == NULL)
+		return;
+
+	if (allocated)
+		delete[] data;
+#ifndef _WIN32
+	else
+		munmap(const_cast<char*>(data), size);
+#endif
+
+	data = NULL;
+	size = 0;
+	allocated = false;
+}
+
+const char* MappedFile::getData() const
+{
+	return data;
+}
+
+size_t MappedFile::getSize() const
+{
+	return size;
+}
@@ -0,0 +1,100 @@
+/**
+ * Bakalarska praca - Simualace pevnych teles
+ * VUT FIT, 2018/2019
+ *
+ * Autor:	Denis Leitner, xleitn02
+ * Subor:	SceneFile.h
+ *
+ */
+
+#pragma once
+
+#ifndef SCENE_FILE_H
+#define SCENE_FILE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+
+namespace fs = std::filesystem;
+
+// first bytes of binary scene file, text scenes never start with them
+constexpr char SCENE_FILE_MAGIC[4] = { 'R', 'B', 'S', 'C' };
+constexpr uint32_t SCENE_FILE_VERSION = 2;
+
+/**
+ * @brief Header of binary scene file; it is followed by model definitions, object records and object names,
+ *        every part starts at offset aligned to 4 bytes, numbers are stored in byte order of the machine
+ */
+struct SceneFileHeader
+{
+	char magic[4];
+	uint32_t version;
+	uint32_t definitionsSize;	// size of model definitions, "m" and "c" lines of text scene
+	uint32_t objectCount;		// number of object records
+	uint32_t namesSize;			// size of names of all objects, names are not terminated
+};
+
+/**
+ * @brief Packed object of binary scene file, the same data as "o" record of text scene, rotation is stored
+ *        as matrix, so that saved objects are loaded back exactly
+ */
+struct SceneObjectRecord
+{
+	uint32_t model;				// index of the model in order of model definitions
+	uint32_t nameOffset;		// offset of the name in names of objects
+	uint32_t nameLength;
+	float density;				// INFINITY for static objects
+	float color[3];
+	float position[3];
+	float rotation[9];			// rotation matrix by columns
+	float velocity[3];
+};
+
+/**
+ * @brief Read-only file mapped into memory, whole file is read into memory where mapping is not available
+ */
+class MappedFile
+{
+public:
+	MappedFile();
+
+	/**
+	 * @brief Unmaps the file
+	 */
+	~MappedFile();
+
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+	/**
+	 * @brief Maps whole file into memory, empty file has no data
+	 * @param filename File to be mapped
+	 * @return Returns true on success, false if file couldn't be opened or mapped
+	 */
+	bool open(const fs::path& filename);
+
+	/**
+	 * @brief Unmaps the file, data are no longer valid
+	 */
+	void close();
+
+	const char* getData() const;
+	size_t getSize() const;
+
+private:
+	const char* data;
+	size_t size;
+	// whether data were read into allocated memory instead of being mapped
+	bool allocated;
+};
+
+/**
+ * @brief Gets offset rounded up to alignment of parts of binary scene file
+ */
+inline size_t alignSceneOffset(size_t offset)
+{
+	return (offset + 3) & ~(size_t)3;
+}
+
+#endif
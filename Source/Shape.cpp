@@ -1,17 +1,17 @@
-/**
- * Bakalarska praca - Simualace pevnych teles
- * VUT FIT, 2018/2019
- *
- * Autor:	Denis Leitner, xleitn02
- * Subor:	Shape.h
- *
- */
-
-#include "Shape.h"
-
-
-Shape::Shape()
-{
-}
-
-Shape::~Shape() = default;
+/**
+ * Bakalarska praca - Simualace pevnych teles
+ * VUT FIT, 2018/2019
+ *
+ * Autor:	Denis Leitner, xleitn02
+ * Subor:	Shape.h
+ *
+ */
+
+#include "Shape.h"
+
+
+Shape::Shape()
+{
+}
+
+Shape::~Shape() = default;
@@ -1,528 +1,916 @@
-/**
- * Bakalarska praca - Simualace pevnych teles
- * VUT FIT, 2018/2019
- *
- * Autor:	Denis Leitner, xleitn02
- * Subor:	Simulation.cpp
- *
- */
-
-#include "Simulation.h"
-
-const glm::vec3 GRAVITY = glm::vec3(0.0f, -9.8f, 0.0f);
-
-Simulation::Simulation()
-{
-	screenWidth = 800;
-	screenHeight = 600;
-	broadPhaseEnabled = false;
-	collisionDetectorBroad = NULL;
-	collisionDetectorNarrow = NULL;
-
-	try
-	{
-		scene = new Scene();
-		renderer = new Renderer();
-		collisionDetectorNarrow = new CollisionDetectionNarrow();
-
-		// set scene to renderer
-		renderer->setScene(scene);
-	}
-	catch (std::bad_alloc & ba)
-	{
-		std::cout << "Could not allocate memory: " << ba.what() << std::endl;
-		throw;
-	}
-}
-
-
-Simulation::~Simulation()
-{
-	if (renderer != NULL)
-	{
-		delete renderer;
-	}
-	if (scene != NULL)
-	{
-		delete scene;
-	}
-	if (collisionDetectorNarrow != NULL)
-	{
-		delete collisionDetectorNarrow;
-	}
-	if (collisionDetectorBroad != NULL)
-	{
-		delete collisionDetectorBroad;
-	}
-}
-
-bool Simulation::initialize()
-{
-	int sceneNumber;
-
-	std::cout << "Enter scene number: ";
-	std::cin >> sceneNumber;
-
-	std::string sceneName = "Scenes/scene_";
-	sceneName = sceneName + std::to_string(sceneNumber);
-
-	fs::path rootDir = fs::u8path(ROOT_DIR);
-	fs::path scenePath = rootDir;
-	fs::path vertexShaderPath = rootDir;
-	fs::path fragmentShaderPath = rootDir;
-
-	fs::path sceneNamePath = fs::path(sceneName);
-	scenePath += sceneNamePath;
-
-	if (!scene->loadScene(scenePath))
-		return false;
-
-	std::cout << std::endl << "Enable broad-phase collision detection? (y/n): ";
-	char broadPhaseInput;
-	std::cin >> broadPhaseInput;
-
-	if (broadPhaseInput == 'y')
-	{
-		broadPhaseEnabled = true;
-		try
-		{
-			// simulation's narrow-phase collision detector will be used by broad-phase collision detector
-			collisionDetectorBroad = new CollisionDetectionBroad(collisionDetectorNarrow);
-		}
-		catch (std::bad_alloc)
-		{
-			return false;
-		}
-
-		collisionDetectorNarrow = NULL;
-		std::cout << "Broad-phase collision detection is enabled" << std::endl;
-	}
-	else
-	{
-		std::cout << "Broad-phase collision detection is disabled" << std::endl;
-	}
-
-	fs::path vertex = fs::path("Shaders/vertex.vert");
-	fs::path fragment = std::filesystem::path("Shaders/fragment.frag");
-
-	vertexShaderPath += vertex;
-	fragmentShaderPath += fragment;
-
-	if (!renderer->initialize(vertexShaderPath, fragmentShaderPath))
-	{
-		std::cout << "Could not initialize renderer" << std::endl;
-		return false;
-	}
-
-	// create VAOs for all models
-	scene->modelManager.createVAOs();
-	mainCamera = scene->getCamera();
-
-	// hide mouse cursor
-	glfwSetInputMode(renderer->window, GLFW_CURSOR, GLFW_CURSOR_DISABLED);
-	// set callback for resizing viewport
-	glfwSetFramebufferSizeCallback(renderer->window, framebufferSizeCallback);
-	// set callback for when mouse is moved
-	glfwSetCursorPosCallback(renderer->window, mouseCallback);
-
-	// recompute initial world-space inverse inertia tensor for every object
-	for (auto & object : scene->objects)
-	{
-		if (object->density != INFINITY)
-			object->computeInverseWorldInertiaTensor();
-		else
-		{
-			if (broadPhaseEnabled)
-			{
-				if (!collisionDetectorBroad->insertStaticObject(object))
-				{
-					std::cout << "Static object \"" << object->objectName << "\" couldn't be inserted into grid\n";
-					return false;
-				}
-			}
-		}
-	}
-
-	return true;
-}
-
-void Simulation::run()
-{
-	renderer->setCamera(mainCamera);
-
-	Shader *myShader = renderer->getShader();
-	myShader->use();
-
-	glfwSetTime(0.0);
-
-	float lastTime = (float)glfwGetTime();
-	float lastFPS = 0.0;
-
-	float accumulator = 0.0f;
-
-	computeForces();
-
-	// main loop
-	while (!glfwWindowShouldClose(renderer->window))
-	{
-		float currentTime = (float)glfwGetTime();
-		float frameTime = currentTime - lastTime;
-
-		lastTime = currentTime;
-
-		if (currentTime - lastFPS >= 1.0f)
-		{
-			char fps[64];
-			snprintf(fps, 64, "Rigid Body Simulation  %f FPS", 1 / frameTime);
-
-			glfwSetWindowTitle(renderer->window, fps);
-			lastFPS = currentTime;
-		}
-
-		processInput(renderer->window, frameTime);
-
-		accumulator += frameTime;
-
-		static int counter = 0;
-		static double acc = 0.0;
-
-		while (accumulator >= msPerUpdate)
-		{
-			double start = glfwGetTime();
-			update();
-			double end = glfwGetTime();
-
-			counter++;
-			acc += (end - start) * 1000.0;
-
-			accumulator -= msPerUpdate;
-		}
-
-		renderer->draw();
-
-		glfwSwapBuffers(renderer->window);
-		glfwPollEvents();
-	}
-}
-
-void Simulation::update()
-{
-	std::vector <Object*>::iterator it;
-
-	for (it = scene->objects.begin(); it != scene->objects.end(); it++)
-	{
-		Object *object = *it;
-		Object::Configuration& configuration = object->configuration;
-
-		// static object
-		if (object->density == INFINITY)
-			continue;
-
-		glm::vec3 acceleration = configuration.force * object->inverseMass;
-
-		configuration.velocityVector += msPerUpdate * acceleration;
-		configuration.angularVelocity = configuration.inverseWorldInertiaTensor * configuration.angularMomentum;
-
-		float damping = 1.0f / (1.0f + msPerUpdate * 0.25f);
-		configuration.velocityVector *= damping;
-		configuration.angularMomentum *= damping;
-
-		configuration.position += msPerUpdate * configuration.velocityVector;
-		configuration.rotation += msPerUpdate * createSkewSymmetric(configuration.angularVelocity) * configuration.rotation;
-
-		object->reorthogonalizeRotationMatrix();
-		object->computeInverseWorldInertiaTensor();
-
-		if (broadPhaseEnabled)
-		{
-			object->aabb->recomputeAABB(object);
-		}
-	}
-
-	if (broadPhaseEnabled)
-	{
-		checkCollisionBroadPhase();
-	}
-	else
-	{
-		checkCollisionNarrowPhase();
-	}
-	applyImpulses();
-}
-
-void Simulation::checkCollisionNarrowPhase()
-{
-	Object* object0;
-	Object* object1;
-
-	const auto& objects = scene->objects;
-	unsigned numberOfObjects = objects.size();
-
-	for (unsigned i = 0; i < numberOfObjects - 1; i++)
-	{
-		object0 = objects[i];
-
-		for (unsigned j = i + 1; j < numberOfObjects; j++)
-		{
-			object1 = objects[j];
-
-			if (object0->mass == INFINITY && object1->mass == INFINITY)
-				// static objects
-				continue;
-
-			CollisionData collision;
-
-			if (collisionDetectorNarrow->checkCollision(collision, object0, object1))
-			{
-				collisionResponse(collision);
-			}
-		}
-	}
-}
-
-void Simulation::checkCollisionBroadPhase()
-{
-	const auto& objects = scene->objects;
-	unsigned int i = 0;
-
-	for (auto & object : objects)
-	{
-		// skip static object, it is already in grid
-		if (object->mass == INFINITY)
-			continue;
-
-		// all actual collisions of object are stored here
-		std::vector<CollisionData> collisions;
-
-		if (!collisionDetectorBroad->check(object, collisions))
-			continue;
-
-		for (auto & collision : collisions)
-		{
-			collisionResponse(collision);
-		}
-		i += collisions.size();
-	}
-
-	collisionDetectorBroad->clearGrid();
-}
-
-void Simulation::applyImpulses()
-{
-	const auto& objects = scene->objects;
-
-	for (unsigned i = 0; i < objects.size(); i++)
-	{
-		Object::Configuration& configuration = objects[i]->configuration;
-
-		// update configuration by impulses
-		configuration.angularVelocity = configuration.inverseWorldInertiaTensor * configuration.angularMomentum;
-		configuration.velocityVector += configuration.velocityAccumulator;
-		configuration.velocityAccumulator = glm::vec3(0.0f);
-	}
-}
-
-void Simulation::computeForces()
-{
-	for (unsigned i = 0; i < scene->objects.size(); i++)
-	{
-		Object* object = scene->objects[i];
-		Object::Configuration& configuration = object->configuration;
-
-		configuration.force = GRAVITY * object->mass;
-		configuration.torque = glm::vec3(0.0f);
-	}
-}
-
-void Simulation::collisionResponse(const CollisionData& collision)
-{
-	if (collision.object0->mass == INFINITY || collision.object1->mass == INFINITY)
-	{
-		// one of the objects is static
-		collisionResponseStatic(collision);
-	}
-	else
-	{
-		// both objects are dynamic
-		collisionResponseDynamic(collision);
-	}
-}
-
-void Simulation::collisionResponseStatic(const CollisionData& collision)
-{
-	Object* object0 = collision.object0;
-	Object* object1 = collision.object1;
-	glm::vec3 collisionNormal = collision.collisionNormal;
-	Object::Configuration& configuration0 = object0->configuration;
-	Object::Configuration& configuration1 = object1->configuration;
-	
-	Object* object;
-	glm::mat4 transformMatrix;
-
-	// only dynamic object will be used in calculation
-	if (object0->mass == INFINITY)
-	{
-		object = object1;
-		transformMatrix = collision.object1->getModelMatrix();
-		collisionNormal = -collisionNormal;
-	}
-	else
-	{
-		object = object0;
-		transformMatrix = collision.object0->getModelMatrix();
-	}
-
-	Object::Configuration& configuration = object->configuration;
-	constexpr float restitution = -(1.0f + COEFFICIENT_OF_RESTITUTION);
-	glm::vec3 centerOfMass = transformMatrix * glm::vec4(object->centerOfMass, 1.0f);
-	glm::vec3 point = collision.collisionPoint;
-
-	glm::vec3 pointImpulse = glm::vec3(0.0f);
-
-	// vector from center of mass of an object to collision point
-	glm::vec3 r0 = point - centerOfMass;
-
-	glm::vec3 pointVelocity = configuration.velocityVector + glm::cross(configuration.angularVelocity, r0);
-	float relativeVelocity = glm::dot(pointVelocity, collisionNormal);
-
-	float subexpression = glm::dot(glm::cross(configuration.inverseWorldInertiaTensor * glm::cross(r0, collisionNormal), r0), collisionNormal);
-	float pointImpulseNumerator = restitution * relativeVelocity;
-	float pointImpulseDenominator = object->inverseMass + subexpression;
-	float pointImpulseMagnitude = pointImpulseNumerator / pointImpulseDenominator;
-	pointImpulse = pointImpulseMagnitude * collisionNormal;
-
-	configuration.angularMomentum += glm::cross(r0, pointImpulse);
-	configuration.velocityAccumulator += (pointImpulse) * object->inverseMass;
-
-	applyDamping(configuration);
-}
-
-void Simulation::collisionResponseDynamic(const CollisionData& collision)
-{
-	Object* object0 = collision.object0;
-	Object* object1 = collision.object1;
-	glm::vec3 collisionNormal = collision.collisionNormal;
-	Object::Configuration& configuration0 = object0->configuration;
-	Object::Configuration& configuration1 = object1->configuration;
-	glm::mat4 transformMatrix0 = object0->getModelMatrix();
-	glm::mat4 transformMatrix1 = object1->getModelMatrix();
-
-	constexpr float restitution = -(1.0f + COEFFICIENT_OF_RESTITUTION);
-	float impulseDenominator = object0->inverseMass + object1->inverseMass;
-
-	glm::vec3 centerOfMassObj0 = transformMatrix0 * glm::vec4(object0->centerOfMass, 1.0f);
-	glm::vec3 centerOfMassObj1 = transformMatrix1 * glm::vec4(object1->centerOfMass, 1.0f);
-
-	glm::vec3 point = collision.collisionPoint;
-
-	// vectors from center of mass of an object to collision point
-	glm::vec3 r0 = point - centerOfMassObj0;
-	glm::vec3 r1 = point - centerOfMassObj1;
-
-	glm::vec3 pointVelocity0 = configuration0.velocityVector + glm::cross(configuration0.angularVelocity, r0);
-	glm::vec3 pointVelocity1 = configuration1.velocityVector + glm::cross(configuration1.angularVelocity, r1);
-	float relativeVelocity = glm::dot(pointVelocity0 - pointVelocity1, collisionNormal);
-
-	auto subexpression0 = glm::cross(configuration0.inverseWorldInertiaTensor * glm::cross(r0, collisionNormal), r0);
-	auto subexpression1 = glm::cross(configuration1.inverseWorldInertiaTensor * glm::cross(r1, collisionNormal), r1);
-
-	float pointImpulseNumerator = restitution * relativeVelocity;
-	float pointImpulseDenominator = impulseDenominator + glm::dot(subexpression0 + subexpression1, collisionNormal);
-	float pointImpulseMagnitude = pointImpulseNumerator / pointImpulseDenominator;
-	glm::vec3 pointImpulse = pointImpulseMagnitude * collisionNormal;
-
-	configuration0.angularMomentum += glm::cross(r0, pointImpulse);
-	configuration1.angularMomentum -= glm::cross(r1, pointImpulse);
-
-	configuration0.velocityAccumulator += pointImpulse * object0->inverseMass;
-	configuration1.velocityAccumulator -= pointImpulse * object1->inverseMass;
-
-	applyDamping(configuration0);
-	applyDamping(configuration1);
-}
-
-void Simulation::applyDamping(Object::Configuration& configuration)
-{
-	float linearVelocity = glm::dot(configuration.velocityVector, configuration.velocityVector);
-	float angularVelocity = glm::dot(configuration.angularVelocity, configuration.angularVelocity);
-
-	if (linearVelocity < restingContactLimit && angularVelocity < restingContactLimit)
-	{
-		configuration.velocityVector *= restingDampingLinear;
-		configuration.angularMomentum *= restingDampingAngular;
-	}
-	else if (linearVelocity < restingContactLimitHigher && angularVelocity < restingContactLimitHigher)
-	{
-		configuration.velocityVector *= restingDampingLinearHigher;
-		configuration.angularMomentum *= restingDampingAngularHigher;
-	}
-}
-
-
-glm::mat3 Simulation::createSkewSymmetric(const glm::vec3& vector)
-{
-	glm::mat3 skewSymmetric = glm::mat3(0.0f);
-
-	skewSymmetric[1][0] = -vector.z;
-	skewSymmetric[2][0] = vector.y;
-	skewSymmetric[0][1] = vector.z;
-	skewSymmetric[2][1] = -vector.x;
-	skewSymmetric[0][2] = -vector.y;
-	skewSymmetric[1][2] = vector.x;
-
-	return skewSymmetric;
-}
-
-void framebufferSizeCallback(GLFWwindow* window, int width, int height)
-{
-	glViewport(0, 0, width, height);
-	SCREEN_WIDTH = width;
-	SCREEN_HEIGHT = height;
-
-	std::cout << "New screen size " << SCREEN_WIDTH << " x " << SCREEN_HEIGHT << std::endl;
-}
-
-void processInput(GLFWwindow* window, float deltaTime)
-{
-	if (glfwGetKey(window, GLFW_KEY_ESCAPE) == GLFW_PRESS)
-		glfwSetWindowShouldClose(window, true);
-	if (glfwGetKey(window, GLFW_KEY_W) == GLFW_PRESS)
-		(*mainCamera).updatePosition('f', deltaTime);
-	if (glfwGetKey(window, GLFW_KEY_S) == GLFW_PRESS)
-		(*mainCamera).updatePosition('b', deltaTime);
-	if (glfwGetKey(window, GLFW_KEY_A) == GLFW_PRESS)
-		(*mainCamera).updatePosition('l', deltaTime);
-	if (glfwGetKey(window, GLFW_KEY_D) == GLFW_PRESS)
-		(*mainCamera).updatePosition('r', deltaTime);
-	if (glfwGetKey(window, GLFW_KEY_LEFT_SHIFT) == GLFW_PRESS)
-		(*mainCamera).updatePosition('u', deltaTime);
-	if (glfwGetKey(window, GLFW_KEY_LEFT_CONTROL) == GLFW_PRESS)
-		(*mainCamera).updatePosition('d', deltaTime);
-}
-
-void mouseCallback(GLFWwindow* window, double xpos, double ypos)
-{
-	// flag if this function is called for the first time
-	static bool first = true;
-	// last position of the mouse on x-axis
-	static float lastX = (float)SCREEN_WIDTH / 2.0f;
-	// last position of the mouse on y-axis
-	static float lastY = (float)SCREEN_HEIGHT / 2.0f;
-
-	// this ensures that camera doesn't change direction suddenly, when the function is called for the first time
-	if (first)
-	{
-		lastX = (float)xpos;
-		lastY = (float)ypos;
-		first = false;
-	}
-
-	// difference in the mouse position
-	float xOffset = (float)xpos - lastX;
-	float yOffset = lastY - (float)ypos;
-
-	lastX = (float)xpos;
-	lastY = (float)ypos;
-
-	(*mainCamera).processMouse(xOffset, yOffset);
-}
+/**
+ * Bakalarska praca - Simualace pevnych teles
+ * VUT FIT, 2018/2019
+ *
+ * Autor:	Denis Leitner, xleitn02
+ * Subor:	Simulation.cpp
+ *
+ */
+
+#include "Simulation.h"
+
+const glm::vec3 GRAVITY = glm::vec3(0.0f, -9.8f, 0.0f);
+
+Simulation::Simulation()
+{
+	screenWidth = 800;
+	screenHeight = 600;
+	autoTuning = false;
+	broadPhase = NULL;
+	threadPool = NULL;
+	collisionDetectorNarrow = NULL;
+
+	try
+	{
+		scene = new Scene();
+		renderer = new Renderer();
+		collisionDetectorNarrow = new CollisionDetectionNarrow();
+		threadPool = new ThreadPool();
+
+		// set scene to renderer
+		renderer->setScene(scene);
+	}
+	catch (std::bad_alloc & ba)
+	{
+		std::cout << "Could not allocate memory: " << ba.what() << std::endl;
+		throw;
+	}
+}
+
+
+Simulation::~Simulation()
+{
+	if (renderer != NULL)
+	{
+		delete renderer;
+	}
+	if (scene != NULL)
+	{
+		delete scene;
+	}
+	if (collisionDetectorNarrow != NULL)
+	{
+		delete collisionDetectorNarrow;
+	}
+	if (broadPhase != NULL)
+	{
+		delete broadPhase;
+	}
+	if (threadPool != NULL)
+	{
+		delete threadPool;
+	}
+}
+
+bool Simulation::initialize()
+{
+	int sceneNumber;
+
+	std::cout << "Enter scene number: ";
+	std::cin >> sceneNumber;
+
+	std::string sceneName = "Scenes/scene_";
+	sceneName = sceneName + std::to_string(sceneNumber);
+
+	fs::path rootDir = fs::u8path(ROOT_DIR);
+	fs::path scenePath = rootDir;
+	fs::path vertexShaderPath = rootDir;
+	fs::path fragmentShaderPath = rootDir;
+
+	fs::path sceneNamePath = fs::path(sceneName);
+	scenePath += sceneNamePath;
+
+	// binary scene written by SceneConverter is loaded instead of the text one, unless the text one or its models changed since
+	fs::path binaryScenePath = scenePath;
+	binaryScenePath += ".bin";
+
+	if (Scene::isBinarySceneCurrent(binaryScenePath, scenePath))
+		scenePath = binaryScenePath;
+
+	if (!scene->loadScene(scenePath, threadPool))
+		return false;
+
+	std::cout << std::endl << "Broad-phase collision detection (a - automatic, g - uniform grid, h - hierarchical grid, l - linear BVH, n - all pairs): ";
+	char broadPhaseInput;
+	std::cin >> broadPhaseInput;
+
+	BroadPhaseSettings broadPhaseSettings;
+
+	switch (broadPhaseInput)
+	{
+	case 'a':
+		// algorithm and its parameters are chosen according to the scene
+		autoTuning = true;
+		broadPhaseSettings = tuner.analyseScene(scene->objects);
+		break;
+	case 'g':
+		broadPhaseSettings.type = uniformGrid;
+		break;
+	case 'h':
+		broadPhaseSettings.type = hierarchicalGrid;
+		break;
+	case 'l':
+		// margin isn't known without analysis of the scene
+		broadPhaseSettings.treeMargin = tuner.analyseScene(scene->objects).treeMargin;
+		broadPhaseSettings.type = linearBVH;
+		break;
+	default:
+		broadPhaseSettings.type = bruteForce;
+		break;
+	}
+
+	if (!createBroadPhase(broadPhaseSettings))
+		return false;
+
+	fs::path vertex = fs::path("Shaders/vertex.vert");
+	fs::path fragment = std::filesystem::path("Shaders/fragment.frag");
+
+	vertexShaderPath += vertex;
+	fragmentShaderPath += fragment;
+
+	if (!renderer->initialize(vertexShaderPath, fragmentShaderPath))
+	{
+		std::cout << "Could not initialize renderer" << std::endl;
+		return false;
+	}
+
+	// create VAOs for all models
+	scene->modelManager.createVAOs();
+	mainCamera = scene->getCamera();
+
+	// hide mouse cursor
+	glfwSetInputMode(renderer->window, GLFW_CURSOR, GLFW_CURSOR_DISABLED);
+	// set callback for resizing viewport
+	glfwSetFramebufferSizeCallback(renderer->window, framebufferSizeCallback);
+	// set callback for when mouse is moved
+	glfwSetCursorPosCallback(renderer->window, mouseCallback);
+
+	// recompute initial world-space inverse inertia tensor for every object
+	for (auto & object : scene->objects)
+	{
+		if (object->density != INFINITY)
+			object->computeInverseWorldInertiaTensor();
+	}
+
+	return true;
+}
+
+bool Simulation::createBroadPhase(const BroadPhaseSettings& settings)
+{
+	if (broadPhase != NULL)
+	{
+		delete broadPhase;
+		broadPhase = NULL;
+	}
+
+	tuner.printSettings(settings);
+
+	broadPhase = BroadPhase::create(settings, threadPool);
+	if (broadPhase == NULL)
+	{
+		std::cout << "Could not create broad phase" << std::endl;
+		return false;
+	}
+
+	std::cout << "Broad-phase collision detection: " << broadPhase->getName() << std::endl;
+
+	halfSpaces.clear();
+	meshes.clear();
+
+	for (auto & object : scene->objects)
+	{
+		if (object->model->shape->type == halfSpace)
+		{
+			// unbounded AABB of half-space would overlap whole scene
+			halfSpaces.push_back(object);
+			continue;
+		}
+
+		if (object->model->shape->type == mesh)
+		{
+			// large AABB of mesh would be inserted in many cells, its triangles have own hierarchy
+			meshes.push_back(object);
+			continue;
+		}
+
+		if (object->density == INFINITY && !broadPhase->insertStaticObject(object))
+		{
+			// object can't collide with objects in grid
+			std::cout << "Static object \"" << object->objectName << "\" is out of grid\n";
+		}
+	}
+
+	return true;
+}
+
+void Simulation::run()
+{
+	renderer->setCamera(mainCamera);
+
+	Shader *myShader = renderer->getShader();
+	myShader->use();
+
+	glfwSetTime(0.0);
+
+	float lastTime = (float)glfwGetTime();
+	float lastFPS = 0.0;
+
+	float accumulator = 0.0f;
+
+	computeForces();
+
+	// main loop
+	while (!glfwWindowShouldClose(renderer->window))
+	{
+		float currentTime = (float)glfwGetTime();
+		float frameTime = currentTime - lastTime;
+
+		lastTime = currentTime;
+
+		if (currentTime - lastFPS >= 1.0f)
+		{
+			char fps[64];
+			snprintf(fps, 64, "Rigid Body Simulation  %f FPS", 1 / frameTime);
+
+			glfwSetWindowTitle(renderer->window, fps);
+			lastFPS = currentTime;
+		}
+
+		processInput(renderer->window, frameTime);
+
+		accumulator += frameTime;
+
+		static int counter = 0;
+		static double acc = 0.0;
+
+		while (accumulator >= msPerUpdate)
+		{
+			double start = glfwGetTime();
+			update();
+			double end = glfwGetTime();
+
+			counter++;
+			acc += (end - start) * 1000.0;
+
+			accumulator -= msPerUpdate;
+		}
+
+		renderer->draw();
+
+		glfwSwapBuffers(renderer->window);
+		glfwPollEvents();
+	}
+}
+
+void Simulation::update()
+{
+	std::vector <Object*>::iterator it;
+
+	for (it = scene->objects.begin(); it != scene->objects.end(); it++)
+	{
+		Object *object = *it;
+		Object::Configuration& configuration = object->configuration;
+
+		// static object
+		if (object->density == INFINITY)
+			continue;
+
+		glm::vec3 acceleration = configuration.force * object->inverseMass;
+
+		configuration.velocityVector += msPerUpdate * acceleration;
+		configuration.angularVelocity = configuration.inverseWorldInertiaTensor * configuration.angularMomentum;
+
+		float damping = 1.0f / (1.0f + msPerUpdate * 0.25f);
+		configuration.velocityVector *= damping;
+		configuration.angularMomentum *= damping;
+
+		object->stepMotion = msPerUpdate * configuration.velocityVector;
+		configuration.position += object->stepMotion;
+		configuration.rotation += msPerUpdate * createSkewSymmetric(configuration.angularVelocity) * configuration.rotation;
+
+		object->reorthogonalizeRotationMatrix();
+		object->computeInverseWorldInertiaTensor();
+		object->aabb->recomputeAABB(object);
+
+		// fast object could pass through thin objects between steps
+		const glm::vec3& halfExtents = object->model->localHalfExtents;
+		float size = 2.0f * std::min(halfExtents.x, std::min(halfExtents.y, halfExtents.z));
+		object->continuous = glm::length(object->stepMotion) > continuousMotionFraction * size;
+
+		if (object->continuous)
+		{
+			// AABB covers whole path of an object during the step
+			object->aabb->sweep(-object->stepMotion);
+		}
+	}
+
+	checkCollisions();
+	applyImpulses();
+
+	if (autoTuning && tuner.needsRetuning())
+	{
+		// pair efficiency drifted, choose broad phase again for current state of the scene
+		createBroadPhase(tuner.analyseScene(scene->objects));
+	}
+}
+
+void Simulation::checkCollisions()
+{
+	// dynamic objects, static objects are already inserted in broad phase
+	std::vector<Object*> dynamicObjects;
+	// pairs of objects whose AABBs overlap
+	std::vector<ObjectPair> pairs;
+
+	for (auto & object : scene->objects)
+	{
+		if (object->mass != INFINITY)
+			dynamicObjects.push_back(object);
+	}
+
+	if (autoTuning && tuner.needsRegrid(dynamicObjects))
+	{
+		// objects left the grid, it is rebuilt before they would miss collisions of this step
+		createBroadPhase(tuner.analyseScene(scene->objects));
+	}
+
+	broadPhase->update(dynamicObjects);
+	broadPhase->findPairs(pairs);
+	findHalfSpacePairs(dynamicObjects, pairs);
+	findMeshPairs(dynamicObjects, pairs);
+	resolveTimeOfImpact(pairs);
+
+	collisions.clear();
+	collisionDetectorNarrow->checkCollisions(pairs, collisions);
+
+	// responses only accumulate impulses, so they can follow detection of all pairs
+	solveContacts();
+	solvePositions();
+
+	tuner.recordStep(pairs.size(), collisions.size());
+}
+
+void Simulation::findHalfSpacePairs(const std::vector<Object*>& dynamicObjects, std::vector<ObjectPair>& pairs)
+{
+	for (auto & space : halfSpaces)
+	{
+		glm::vec3 normal;
+		float offset = collisionDetectorNarrow->getHalfSpacePlane(space, normal);
+
+		for (auto & object : dynamicObjects)
+		{
+			// corner of AABB that is the deepest along normal
+			glm::vec3 corner;
+			for (int i = 0; i < 3; i++)
+				corner[i] = normal[i] > 0.0f ? object->aabb->min[i] : object->aabb->max[i];
+
+			if (glm::dot(normal, corner) <= offset)
+				pairs.push_back({ space, object });
+		}
+	}
+}
+
+void Simulation::findMeshPairs(const std::vector<Object*>& dynamicObjects, std::vector<ObjectPair>& pairs)
+{
+	for (auto & meshObject : meshes)
+	{
+		const AABB* bounds = meshObject->aabb;
+
+		for (auto & object : dynamicObjects)
+		{
+			if (object->aabb->min.x <= bounds->max.x && object->aabb->max.x >= bounds->min.x
+				&& object->aabb->min.y <= bounds->max.y && object->aabb->max.y >= bounds->min.y
+				&& object->aabb->min.z <= bounds->max.z && object->aabb->max.z >= bounds->min.z)
+				pairs.push_back({ meshObject, object });
+		}
+	}
+}
+
+void Simulation::resolveTimeOfImpact(const std::vector<ObjectPair>& pairs)
+{
+	// the first time of impact of every fast object
+	std::unordered_map<Object*, float> impactTimes;
+
+	for (auto & pair : pairs)
+	{
+		Object* objects[2] = { pair.object0, pair.object1 };
+
+		for (int i = 0; i < 2; i++)
+		{
+			Object* object = objects[i];
+			Object* other = objects[1 - i];
+
+			if (!object->continuous)
+				continue;
+
+			float time;
+			if (!collisionDetectorNarrow->findTimeOfImpact(object, other, object->stepMotion, time))
+				continue;
+
+			auto it = impactTimes.find(object);
+			if (it == impactTimes.end())
+				impactTimes[object] = time;
+			else
+				it->second = std::min(it->second, time);
+		}
+	}
+
+	for (auto & impact : impactTimes)
+	{
+		Object* object = impact.first;
+		glm::vec3 motion = object->stepMotion;
+
+		// move object back to the contact and slightly into it, rest of the motion is lost
+		float time = std::min(impact.second + continuousContactDepth / glm::length(motion), 1.0f);
+		object->configuration.position -= (1.0f - time) * motion;
+		object->stepMotion = time * motion;
+		object->aabb->recomputeAABB(object);
+	}
+}
+
+void Simulation::applyImpulses()
+{
+	const auto& objects = scene->objects;
+
+	for (unsigned i = 0; i < objects.size(); i++)
+	{
+		Object::Configuration& configuration = objects[i]->configuration;
+
+		// update configuration by impulses
+		configuration.angularVelocity = configuration.inverseWorldInertiaTensor * configuration.angularMomentum;
+		configuration.velocityVector += configuration.velocityAccumulator;
+		configuration.velocityAccumulator = glm::vec3(0.0f);
+	}
+}
+
+void Simulation::computeForces()
+{
+	for (unsigned i = 0; i < scene->objects.size(); i++)
+	{
+		Object* object = scene->objects[i];
+		Object::Configuration& configuration = object->configuration;
+
+		configuration.force = GRAVITY * object->mass;
+		configuration.torque = glm::vec3(0.0f);
+	}
+}
+
+void Simulation::colorContacts()
+{
+	// colour of every contact, solverColorCount for contacts that didn't get any
+	std::vector<unsigned> contactColors(collisions.size());
+	colorStarts.assign(solverColorCount + 2, 0);
+	objectColors.clear();
+
+	for (unsigned i = 0; i < collisions.size(); i++)
+	{
+		Object* objects[2] = { collisions[i].object0, collisions[i].object1 };
+		uint64_t* masks[2] = { NULL, NULL };
+		uint64_t used = 0;
+
+		for (int j = 0; j < 2; j++)
+		{
+			if (objects[j]->mass == INFINITY)
+				continue;
+
+			// references to elements stay valid when map grows
+			masks[j] = &objectColors[objects[j]];
+			used |= *masks[j];
+		}
+
+		unsigned color = 0;
+		while (color < solverColorCount && (used >> color) & 1)
+			color++;
+
+		if (color < solverColorCount)
+		{
+			for (auto & mask : masks)
+				if (mask != NULL)
+					*mask |= (uint64_t)1 << color;
+		}
+
+		contactColors[i] = color;
+		colorStarts[color + 1]++;
+	}
+
+	for (unsigned color = 0; color <= solverColorCount; color++)
+		colorStarts[color + 1] += colorStarts[color];
+
+	// contacts of one colour stay in order in which they were found
+	std::vector<unsigned> positions(colorStarts.begin(), colorStarts.end() - 1);
+	coloredContacts.resize(collisions.size());
+
+	for (unsigned i = 0; i < collisions.size(); i++)
+		coloredContacts[positions[contactColors[i]]++] = i;
+}
+
+void Simulation::solveContacts()
+{
+	colorContacts();
+
+	for (unsigned color = 0; color < solverColorCount; color++)
+	{
+		unsigned first = colorStarts[color];
+		unsigned count = colorStarts[color + 1] - first;
+
+		if (count == 0)
+			continue;
+
+		threadPool->parallelFor(count, [this, first](unsigned begin, unsigned end, unsigned /*thread*/)
+		{
+			for (unsigned i = begin; i < end; i += solverBatchSize)
+				solveContactBatch(&coloredContacts[first + i], std::min(solverBatchSize, end - i));
+		});
+	}
+
+	// contacts left without colour may share objects, they are resolved by the calling thread
+	for (unsigned i = colorStarts[solverColorCount]; i < colorStarts[solverColorCount + 1]; i++)
+		collisionResponse(collisions[coloredContacts[i]]);
+}
+
+void Simulation::solvePositions()
+{
+	pushImpulses.assign(collisions.size(), 0.0f);
+
+	// contacts of one colour share no dynamic object, colours of contacts are reused from velocity solver
+	for (unsigned iteration = 0; iteration < positionIterations; iteration++)
+	{
+		for (unsigned color = 0; color < solverColorCount; color++)
+		{
+			unsigned first = colorStarts[color];
+			unsigned count = colorStarts[color + 1] - first;
+
+			if (count == 0)
+				continue;
+
+			threadPool->parallelFor(count, [this, first](unsigned begin, unsigned end, unsigned /*thread*/)
+			{
+				for (unsigned i = begin; i < end; i++)
+					solvePositionContact(coloredContacts[first + i]);
+			});
+		}
+
+		for (unsigned i = colorStarts[solverColorCount]; i < colorStarts[solverColorCount + 1]; i++)
+			solvePositionContact(coloredContacts[i]);
+	}
+
+	for (auto & object : scene->objects)
+	{
+		Object::Configuration& configuration = object->configuration;
+
+		// displacement is applied directly, it isn't scaled by time step and doesn't persist
+		configuration.position += configuration.pushDisplacement;
+		configuration.pushDisplacement = glm::vec3(0.0f);
+	}
+}
+
+void Simulation::solvePositionContact(unsigned index)
+{
+	const CollisionData& collision = collisions[index];
+	Object* object0 = collision.object0;
+	Object* object1 = collision.object1;
+	bool dynamic0 = object0->mass != INFINITY;
+	bool dynamic1 = object1->mass != INFINITY;
+
+	float inverseMass = (dynamic0 ? object0->inverseMass : 0.0f) + (dynamic1 ? object1->inverseMass : 0.0f);
+	if (inverseMass == 0.0f)
+		return;
+
+	glm::vec3 displacement0 = dynamic0 ? object0->configuration.pushDisplacement : glm::vec3(0.0f);
+	glm::vec3 displacement1 = dynamic1 ? object1->configuration.pushDisplacement : glm::vec3(0.0f);
+
+	// separation still missing after pushes of previous iterations
+	float target = positionCorrection * std::max(collision.depth - penetrationSlop, 0.0f);
+	float separating = glm::dot(displacement0 - displacement1, collision.collisionNormal);
+
+	// accumulated impulse only pushes objects apart
+	float impulse = (target - separating) / inverseMass;
+	float accumulated = std::max(pushImpulses[index] + impulse, 0.0f);
+	impulse = accumulated - pushImpulses[index];
+	pushImpulses[index] = accumulated;
+
+	glm::vec3 push = impulse * collision.collisionNormal;
+
+	if (dynamic0)
+		object0->configuration.pushDisplacement += push * object0->inverseMass;
+
+	if (dynamic1)
+		object1->configuration.pushDisplacement -= push * object1->inverseMass;
+}
+
+void Simulation::solveContactBatch(const unsigned* contacts, unsigned count)
+{
+	constexpr float restitution = -(1.0f + COEFFICIENT_OF_RESTITUTION);
+
+	// lanes of the batch, unused lanes keep values that give zero impulse without division by zero
+	float normalX[solverBatchSize] = {}, normalY[solverBatchSize] = {}, normalZ[solverBatchSize] = {};
+	float r0X[solverBatchSize] = {}, r0Y[solverBatchSize] = {}, r0Z[solverBatchSize] = {};
+	float r1X[solverBatchSize] = {}, r1Y[solverBatchSize] = {}, r1Z[solverBatchSize] = {};
+	float velocity0X[solverBatchSize] = {}, velocity0Y[solverBatchSize] = {}, velocity0Z[solverBatchSize] = {};
+	float velocity1X[solverBatchSize] = {}, velocity1Y[solverBatchSize] = {}, velocity1Z[solverBatchSize] = {};
+	float angular0X[solverBatchSize] = {}, angular0Y[solverBatchSize] = {}, angular0Z[solverBatchSize] = {};
+	float angular1X[solverBatchSize] = {}, angular1Y[solverBatchSize] = {}, angular1Z[solverBatchSize] = {};
+	// inverse world inertia tensors, element [column * 3 + row]
+	float inertia0[9][solverBatchSize] = {}, inertia1[9][solverBatchSize] = {};
+	float inverseMass0[solverBatchSize];
+	float inverseMass1[solverBatchSize] = {};
+	float impulse[solverBatchSize];
+
+	// unused lanes keep denominator of impulse non-zero, their numerator is zero
+	for (unsigned i = 0; i < solverBatchSize; i++)
+		inverseMass0[i] = 1.0f;
+
+	// gather
+	for (unsigned i = 0; i < count; i++)
+	{
+		const CollisionData& collision = collisions[contacts[i]];
+		Object* objects[2] = { collision.object0, collision.object1 };
+		float* r[2][3] = { { r0X, r0Y, r0Z }, { r1X, r1Y, r1Z } };
+		float* velocity[2][3] = { { velocity0X, velocity0Y, velocity0Z }, { velocity1X, velocity1Y, velocity1Z } };
+		float* angular[2][3] = { { angular0X, angular0Y, angular0Z }, { angular1X, angular1Y, angular1Z } };
+		float (*inertia[2])[solverBatchSize] = { inertia0, inertia1 };
+		float* inverseMass[2] = { inverseMass0, inverseMass1 };
+
+		normalX[i] = collision.collisionNormal.x;
+		normalY[i] = collision.collisionNormal.y;
+		normalZ[i] = collision.collisionNormal.z;
+
+		for (int j = 0; j < 2; j++)
+		{
+			Object* object = objects[j];
+			inverseMass[j][i] = object->inverseMass;
+
+			// velocity of static object is ignored, its other values are zero
+			if (object->mass == INFINITY)
+				continue;
+
+			const Object::Configuration& configuration = object->configuration;
+			glm::vec3 centerOfMass = configuration.rotation * object->centerOfMass + configuration.position;
+			glm::vec3 arm = collision.collisionPoint - centerOfMass;
+
+			for (int k = 0; k < 3; k++)
+			{
+				r[j][k][i] = arm[k];
+				velocity[j][k][i] = configuration.velocityVector[k];
+				angular[j][k][i] = configuration.angularVelocity[k];
+			}
+
+			for (int column = 0; column < 3; column++)
+				for (int row = 0; row < 3; row++)
+					inertia[j][column * 3 + row][i] = configuration.inverseWorldInertiaTensor[column][row];
+		}
+	}
+
+	// impulse magnitudes, the same computation as in collisionResponseDynamic
+	for (unsigned i = 0; i < solverBatchSize; i++)
+	{
+		// velocities of contact point
+		float point0X = velocity0X[i] + angular0Y[i] * r0Z[i] - angular0Z[i] * r0Y[i];
+		float point0Y = velocity0Y[i] + angular0Z[i] * r0X[i] - angular0X[i] * r0Z[i];
+		float point0Z = velocity0Z[i] + angular0X[i] * r0Y[i] - angular0Y[i] * r0X[i];
+		float point1X = velocity1X[i] + angular1Y[i] * r1Z[i] - angular1Z[i] * r1Y[i];
+		float point1Y = velocity1Y[i] + angular1Z[i] * r1X[i] - angular1X[i] * r1Z[i];
+		float point1Z = velocity1Z[i] + angular1X[i] * r1Y[i] - angular1Y[i] * r1X[i];
+
+		float relativeVelocity = normalX[i] * (point0X - point1X) + normalY[i] * (point0Y - point1Y) + normalZ[i] * (point0Z - point1Z);
+
+		// r x n
+		float cross0X = r0Y[i] * normalZ[i] - r0Z[i] * normalY[i];
+		float cross0Y = r0Z[i] * normalX[i] - r0X[i] * normalZ[i];
+		float cross0Z = r0X[i] * normalY[i] - r0Y[i] * normalX[i];
+		float cross1X = r1Y[i] * normalZ[i] - r1Z[i] * normalY[i];
+		float cross1Y = r1Z[i] * normalX[i] - r1X[i] * normalZ[i];
+		float cross1Z = r1X[i] * normalY[i] - r1Y[i] * normalX[i];
+
+		// I^-1 (r x n)
+		float turn0X = inertia0[0][i] * cross0X + inertia0[3][i] * cross0Y + inertia0[6][i] * cross0Z;
+		float turn0Y = inertia0[1][i] * cross0X + inertia0[4][i] * cross0Y + inertia0[7][i] * cross0Z;
+		float turn0Z = inertia0[2][i] * cross0X + inertia0[5][i] * cross0Y + inertia0[8][i] * cross0Z;
+		float turn1X = inertia1[0][i] * cross1X + inertia1[3][i] * cross1Y + inertia1[6][i] * cross1Z;
+		float turn1Y = inertia1[1][i] * cross1X + inertia1[4][i] * cross1Y + inertia1[7][i] * cross1Z;
+		float turn1Z = inertia1[2][i] * cross1X + inertia1[5][i] * cross1Y + inertia1[8][i] * cross1Z;
+
+		// (I^-1 (r x n)) x r
+		float sumX = turn0Y * r0Z[i] - turn0Z * r0Y[i] + turn1Y * r1Z[i] - turn1Z * r1Y[i];
+		float sumY = turn0Z * r0X[i] - turn0X * r0Z[i] + turn1Z * r1X[i] - turn1X * r1Z[i];
+		float sumZ = turn0X * r0Y[i] - turn0Y * r0X[i] + turn1X * r1Y[i] - turn1Y * r1X[i];
+
+		float denominator = inverseMass0[i] + inverseMass1[i] + normalX[i] * sumX + normalY[i] * sumY + normalZ[i] * sumZ;
+		impulse[i] = restitution * relativeVelocity / denominator;
+	}
+
+	// scatter
+	for (unsigned i = 0; i < count; i++)
+	{
+		const CollisionData& collision = collisions[contacts[i]];
+		glm::vec3 pointImpulse = impulse[i] * collision.collisionNormal;
+
+		if (collision.object0->mass != INFINITY)
+		{
+			Object::Configuration& configuration = collision.object0->configuration;
+			configuration.angularMomentum += glm::cross(glm::vec3(r0X[i], r0Y[i], r0Z[i]), pointImpulse);
+			configuration.velocityAccumulator += pointImpulse * collision.object0->inverseMass;
+			applyDamping(configuration);
+		}
+
+		if (collision.object1->mass != INFINITY)
+		{
+			Object::Configuration& configuration = collision.object1->configuration;
+			configuration.angularMomentum -= glm::cross(glm::vec3(r1X[i], r1Y[i], r1Z[i]), pointImpulse);
+			configuration.velocityAccumulator -= pointImpulse * collision.object1->inverseMass;
+			applyDamping(configuration);
+		}
+	}
+}
+
+void Simulation::collisionResponse(const CollisionData& collision)
+{
+	if (collision.object0->mass == INFINITY || collision.object1->mass == INFINITY)
+	{
+		// one of the objects is static
+		collisionResponseStatic(collision);
+	}
+	else
+	{
+		// both objects are dynamic
+		collisionResponseDynamic(collision);
+	}
+}
+
+void Simulation::collisionResponseStatic(const CollisionData& collision)
+{
+	Object* object0 = collision.object0;
+	Object* object1 = collision.object1;
+	glm::vec3 collisionNormal = collision.collisionNormal;
+	Object::Configuration& configuration0 = object0->configuration;
+	Object::Configuration& configuration1 = object1->configuration;
+	
+	Object* object;
+	glm::mat4 transformMatrix;
+
+	// only dynamic object will be used in calculation
+	if (object0->mass == INFINITY)
+	{
+		object = object1;
+		transformMatrix = collision.object1->getModelMatrix();
+		collisionNormal = -collisionNormal;
+	}
+	else
+	{
+		object = object0;
+		transformMatrix = collision.object0->getModelMatrix();
+	}
+
+	Object::Configuration& configuration = object->configuration;
+	constexpr float restitution = -(1.0f + COEFFICIENT_OF_RESTITUTION);
+	glm::vec3 centerOfMass = transformMatrix * glm::vec4(object->centerOfMass, 1.0f);
+	glm::vec3 point = collision.collisionPoint;
+
+	glm::vec3 pointImpulse = glm::vec3(0.0f);
+
+	// vector from center of mass of an object to collision point
+	glm::vec3 r0 = point - centerOfMass;
+
+	glm::vec3 pointVelocity = configuration.velocityVector + glm::cross(configuration.angularVelocity, r0);
+	float relativeVelocity = glm::dot(pointVelocity, collisionNormal);
+
+	float subexpression = glm::dot(glm::cross(configuration.inverseWorldInertiaTensor * glm::cross(r0, collisionNormal), r0), collisionNormal);
+	float pointImpulseNumerator = restitution * relativeVelocity;
+	float pointImpulseDenominator = object->inverseMass + subexpression;
+	float pointImpulseMagnitude = pointImpulseNumerator / pointImpulseDenominator;
+	pointImpulse = pointImpulseMagnitude * collisionNormal;
+
+	configuration.angularMomentum += glm::cross(r0, pointImpulse);
+	configuration.velocityAccumulator += (pointImpulse) * object->inverseMass;
+
+	applyDamping(configuration);
+}
+
+void Simulation::collisionResponseDynamic(const CollisionData& collision)
+{
+	Object* object0 = collision.object0;
+	Object* object1 = collision.object1;
+	glm::vec3 collisionNormal = collision.collisionNormal;
+	Object::Configuration& configuration0 = object0->configuration;
+	Object::Configuration& configuration1 = object1->configuration;
+	glm::mat4 transformMatrix0 = object0->getModelMatrix();
+	glm::mat4 transformMatrix1 = object1->getModelMatrix();
+
+	constexpr float restitution = -(1.0f + COEFFICIENT_OF_RESTITUTION);
+	float impulseDenominator = object0->inverseMass + object1->inverseMass;
+
+	glm::vec3 centerOfMassObj0 = transformMatrix0 * glm::vec4(object0->centerOfMass, 1.0f);
+	glm::vec3 centerOfMassObj1 = transformMatrix1 * glm::vec4(object1->centerOfMass, 1.0f);
+
+	glm::vec3 point = collision.collisionPoint;
+
+	// vectors from center of mass of an object to collision point
+	glm::vec3 r0 = point - centerOfMassObj0;
+	glm::vec3 r1 = point - centerOfMassObj1;
+
+	glm::vec3 pointVelocity0 = configuration0.velocityVector + glm::cross(configuration0.angularVelocity, r0);
+	glm::vec3 pointVelocity1 = configuration1.velocityVector + glm::cross(configuration1.angularVelocity, r1);
+	float relativeVelocity = glm::dot(pointVelocity0 - pointVelocity1, collisionNormal);
+
+	auto subexpression0 = glm::cross(configuration0.inverseWorldInertiaTensor * glm::cross(r0, collisionNormal), r0);
+	auto subexpression1 = glm::cross(configuration1.inverseWorldInertiaTensor * glm::cross(r1, collisionNormal), r1);
+
+	float pointImpulseNumerator = restitution * relativeVelocity;
+	float pointImpulseDenominator = impulseDenominator + glm::dot(subexpression0 + subexpression1, collisionNormal);
+	float pointImpulseMagnitude = pointImpulseNumerator / pointImpulseDenominator;
+	glm::vec3 pointImpulse = pointImpulseMagnitude * collisionNormal;
+
+	configuration0.angularMomentum += glm::cross(r0, pointImpulse);
+	configuration1.angularMomentum -= glm::cross(r1, pointImpulse);
+
+	configuration0.velocityAccumulator += pointImpulse * object0->inverseMass;
+	configuration1.velocityAccumulator -= pointImpulse * object1->inverseMass;
+
+	applyDamping(configuration0);
+	applyDamping(configuration1);
+}
+
+void Simulation::applyDamping(Object::Configuration& configuration)
+{
+	float linearVelocity = glm::dot(configuration.velocityVector, configuration.velocityVector);
+	float angularVelocity = glm::dot(configuration.angularVelocity, configuration.angularVelocity);
+
+	if (linearVelocity < restingContactLimit && angularVelocity < restingContactLimit)
+	{
+		configuration.velocityVector *= restingDampingLinear;
+		configuration.angularMomentum *= restingDampingAngular;
+	}
+	else if (linearVelocity < restingContactLimitHigher && angularVelocity < restingContactLimitHigher)
+	{
+		configuration.velocityVector *= restingDampingLinearHigher;
+		configuration.angularMomentum *= restingDampingAngularHigher;
+	}
+}
+
+
+glm::mat3 Simulation::createSkewSymmetric(const glm::vec3& vector)
+{
+	glm::mat3 skewSymmetric = glm::mat3(0.0f);
+
+	skewSymmetric[1][0] = -vector.z;
+	skewSymmetric[2][0] = vector.y;
+	skewSymmetric[0][1] = vector.z;
+	skewSymmetric[2][1] = -vector.x;
+	skewSymmetric[0][2] = -vector.y;
+	skewSymmetric[1][2] = vector.x;
+
+	return skewSymmetric;
+}
+
+void framebufferSizeCallback(GLFWwindow* window, int width, int height)
+{
+	glViewport(0, 0, width, height);
+	SCREEN_WIDTH = width;
+	SCREEN_HEIGHT = height;
+
+	std::cout << "New screen size " << SCREEN_WIDTH << " x " << SCREEN_HEIGHT << std::endl;
+}
+
+void processInput(GLFWwindow* window, float deltaTime)
+{
+	if (glfwGetKey(window, GLFW_KEY_ESCAPE) == GLFW_PRESS)
+		glfwSetWindowShouldClose(window, true);
+	if (glfwGetKey(window, GLFW_KEY_W) == GLFW_PRESS)
+		(*mainCamera).updatePosition('f', deltaTime);
+	if (glfwGetKey(window, GLFW_KEY_S) == GLFW_PRESS)
+		(*mainCamera).updatePosition('b', deltaTime);
+	if (glfwGetKey(window, GLFW_KEY_A) == GLFW_PRESS)
+		(*mainCamera).updatePosition('l', deltaTime);
+	if (glfwGetKey(window, GLFW_KEY_D) == GLFW_PRESS)
+		(*mainCamera).updatePosition('r', deltaTime);
+	if (glfwGetKey(window, GLFW_KEY_LEFT_SHIFT) == GLFW_PRESS)
+		(*mainCamera).updatePosition('u', deltaTime);
+	if (glfwGetKey(window, GLFW_KEY_LEFT_CONTROL) == GLFW_PRESS)
+		(*mainCamera).updatePosition('d', deltaTime);
+}
+
+void mouseCallback(GLFWwindow* window, double xpos, double ypos)
+{
+	// flag if this function is called for the first time
+	static bool first = true;
+	// last position of the mouse on x-axis
+	static float lastX = (float)SCREEN_WIDTH / 2.0f;
+	// last position of the mouse on y-axis
+	static float lastY = (float)SCREEN_HEIGHT / 2.0f;
+
+	// this ensures that camera doesn't change direction suddenly, when the function is called for the first time
+	if (first)
+	{
+		lastX = (float)xpos;
+		lastY = (float)ypos;
+		first = false;
+	}
+
+	// difference in the mouse position
+	float xOffset = (float)xpos - lastX;
+	float yOffset = lastY - (float)ypos;
+
+	lastX = (float)xpos;
+	lastY = (float)ypos;
+
+	(*mainCamera).processMouse(xOffset, yOffset);
+}
@@ -1,153 +1,243 @@
-/**
- * Bakalarska praca - Simualace pevnych teles
- * VUT FIT, 2018/2019
- *
- * Autor:	Denis Leitner, xleitn02
- * Subor:	Simulation.h
- *
- */
-
-#pragma once
-
-#ifndef SIMULATION_H
-#define SIMULATION_H
-
-#define GLM_ENABLE_EXPERIMENTAL
-#include <glm/gtc/matrix_transform.hpp>
-
-#include "Renderer.h"
-#include "Scene.h"
-#include "CollisionDetectionBroad.h"
-
-constexpr float msPerUpdate = 0.01f;
-constexpr float restingContactLimit = 0.3f;
-constexpr float restingContactLimitHigher = 0.7f;
-constexpr float restingDampingAngular = 0.7f;
-constexpr float restingDampingAngularHigher = 0.85f;
-constexpr float restingDampingLinear = 0.9f;
-constexpr float restingDampingLinearHigher = 0.95f;
-
-static Camera *mainCamera;
-
-class Simulation
-{
-public:
-	/**
-	 * @brief Constructor, creates scene object and renderer object
-	 */
-	Simulation();
-
-	/**
-	 * @brief Destructor, deletes all resources
-	 */
-	~Simulation();
-
-	/**
-	 * @brief	Loads models, creates scene and initializes renderer
-	 * @return	Returns true on success, false on failure
-	 */
-	bool initialize();
-
-	/**
-	 * @brief Runs simulation
-	 */
-	void run();
-
-private:
-	// width of the screen in pixels
-	unsigned int screenWidth;
-	// height of the screen in pixels
-	unsigned int screenHeight;
-
-	// simulated scene
-	Scene *scene;
-	// renderer of the simulation
-	Renderer *renderer;
-	// narrow-phase collision detector
-	CollisionDetectionNarrow* collisionDetectorNarrow;
-	// broad-phase collision detector, NULL if broad-phase is disabled
-	CollisionDetectionBroad* collisionDetectorBroad;
-
-	// indicates whether broad-phase collision is enabled
-	bool broadPhaseEnabled;
-
-	/** 
-	 * @brief Updates position of the objects in scene
-	 */
-	void update();
-
-	/**
-	 * @brief Checks for collision between objects and resolves it; only narrow phase
-	 */
-	void checkCollisionNarrowPhase();
-
-	/**
-	 * @brief Checks for collision; broad and narrow phase
-	 */
-	void checkCollisionBroadPhase();
-
-	/**
-	 * @brief Applies impulses to all objects' linear and angular velocities accumulated throughout one update
-	 */
-	void applyImpulses();
-
-	/**
-	 * @brief Computes forces acting on all objects
-	 */
-	void computeForces();
-
-	/**
-	 * @brief Calculates impulses for collision response and stores them in objects' configuration
-	 * @param collision Collision data
-	 */
-	void collisionResponse(const CollisionData& collision);
-
-	/**
-	 * @brief Collision response for static and dynamic object
-	 * @param collision Collision data
-	 */
-	void collisionResponseStatic(const CollisionData& collision);
-
-	/**
-	 * @brief Collision response for dynamic objects
-	 * @param collision Collision data
-	 */
-	void collisionResponseDynamic(const CollisionData& collision);
-
-	/**
-	 * @brief Applies damping to linear and angular velocity if object's velocities are low
-	 * @param configuration Configuration of an object to which to apply damping
-	 */
-	void applyDamping(Object::Configuration& configuration);
-
-	/**
-	 * @brief Constructs skew-symmetric matrix for given vector
-	 * @param vector Vector for which to construct skew-symmetric matrix
-	 * @return Constructed skew-symmetric matrix
-	 */
-	glm::mat3 createSkewSymmetric(const glm::vec3& vector);
-};
-
-/**
- * @brief Processes user input from keyboard
- * @param window	Window whose input to process
- */
-void processInput(GLFWwindow* window, float deltaTime);
-
-/**
- * @brief Callback function, called when mouse is moved
- * @param window	Window whose mouse input to be captured
- * @param xpos		Actual position of mouse on x - axis
- * @param ypos		Actual position of mouse on y - axis
- */
-void mouseCallback(GLFWwindow* window, double xpos, double ypos);
-
-/**
- * @brief Callback function for resizing viewport when window size is changed
- * @param window	Window whose size to resize
- * @param width		New width of viewport to be set
- * @param height	New height of viewport to be set
- */
-void framebufferSizeCallback(GLFWwindow* window, int width, int height);
-
+/**
+ * Bakalarska praca - Simualace pevnych teles
+ * VUT FIT, 2018/2019
+ *
+ * Autor:	Denis Leitner, xleitn02
+ * Subor:	Simulation.h
+ *
+ */
+
+#pragma once
+
+#ifndef SIMULATION_H
+#define SIMULATION_H
+
+#define GLM_ENABLE_EXPERIMENTAL
+#include <glm/gtc/matrix_transform.hpp>
+#include <unordered_map>
+
+#include "Renderer.h"
+#include "Scene.h"
+#include "CollisionDetectionNarrow.h"
+#include "BroadPhaseTuner.h"
+
+constexpr float msPerUpdate = 0.01f;
+constexpr float restingContactLimit = 0.3f;
+constexpr float restingContactLimitHigher = 0.7f;
+constexpr float restingDampingAngular = 0.7f;
+constexpr float restingDampingAngularHigher = 0.85f;
+constexpr float restingDampingLinear = 0.9f;
+constexpr float restingDampingLinearHigher = 0.95f;
+// fraction of the smallest size of an object it has to move during one step to be checked continuously
+constexpr float continuousMotionFraction = 0.25f;
+// depth to which fast object is moved into object it hits, so that discrete collision detection finds the contact
+constexpr float continuousContactDepth = 0.01f;
+// number of colours of contact graph, contacts that don't fit into any of them are solved by one thread at the end
+constexpr unsigned solverColorCount = 64;
+// number of contacts of one colour resolved together in structure of arrays, so that compiler can vectorize it
+constexpr unsigned solverBatchSize = 8;
+// iterations of position solver over all contacts of one step
+constexpr unsigned positionIterations = 8;
+// fraction of penetration removed by position solver in one step
+constexpr float positionCorrection = 0.8f;
+// penetration left in resting contacts, so that they are found again in the next step
+constexpr float penetrationSlop = 0.005f;
+
+static Camera *mainCamera;
+
+class Simulation
+{
+public:
+	/**
+	 * @brief Constructor, creates scene object and renderer object
+	 */
+	Simulation();
+
+	/**
+	 * @brief Destructor, deletes all resources
+	 */
+	~Simulation();
+
+	/**
+	 * @brief	Loads models, creates scene and initializes renderer
+	 * @return	Returns true on success, false on failure
+	 */
+	bool initialize();
+
+	/**
+	 * @brief Runs simulation
+	 */
+	void run();
+
+private:
+	// width of the screen in pixels
+	unsigned int screenWidth;
+	// height of the screen in pixels
+	unsigned int screenHeight;
+
+	// simulated scene
+	Scene *scene;
+	// renderer of the simulation
+	Renderer *renderer;
+	// narrow-phase collision detector
+	CollisionDetectionNarrow* collisionDetectorNarrow;
+	// broad-phase collision detector
+	BroadPhase* broadPhase;
+	// half-spaces are tested against every dynamic object directly, they aren't inserted in broad phase
+	std::vector<Object*> halfSpaces;
+	// triangle meshes are tested against dynamic objects overlapping their AABBs, their triangles are culled by narrow phase
+	std::vector<Object*> meshes;
+	// collisions found in the current step, kept between steps to avoid allocation
+	std::vector<CollisionData> collisions;
+	// indices of collisions sorted by colour, contacts of one colour share no dynamic object
+	std::vector<unsigned> coloredContacts;
+	// index of the first contact of every colour in coloredContacts, the last entry is their count
+	std::vector<unsigned> colorStarts;
+	// colours used by contacts of every dynamic object in the current step, one bit per colour
+	std::unordered_map<Object*, uint64_t> objectColors;
+	// impulse of position solver accumulated by every contact of the current step
+	std::vector<float> pushImpulses;
+	// worker threads shared by parallel parts of the simulation
+	ThreadPool* threadPool;
+
+	// indicates whether broad phase is chosen and retuned automatically
+	bool autoTuning;
+	// chooses broad phase from scene statistics
+	BroadPhaseTuner tuner;
+
+	/**
+	 * @brief Creates broad-phase collision detector and inserts static objects into it, replaces existing one
+	 * @param settings Type and parameters of broad phase
+	 * @return Whether broad phase was created
+	 */
+	bool createBroadPhase(const BroadPhaseSettings& settings);
+
+	/** 
+	 * @brief Updates position of the objects in scene
+	 */
+	void update();
+
+	/**
+	 * @brief Checks for collision between objects and resolves it; broad and narrow phase
+	 */
+	void checkCollisions();
+
+	/**
+	 * @brief Moves fast objects back to the first time of impact with their potential collision partners
+	 *        found during the step, so that they don't pass through other objects
+	 * @param pairs Pairs found by broad phase with swept AABBs of fast objects
+	 */
+	void resolveTimeOfImpact(const std::vector<ObjectPair>& pairs);
+
+	/**
+	 * @brief Finds pairs of half-spaces and dynamic objects whose AABBs reach below boundary plane
+	 * @param dynamicObjects Dynamic objects of the scene
+	 * @param[out] pairs Found pairs are appended to this vector
+	 */
+	void findHalfSpacePairs(const std::vector<Object*>& dynamicObjects, std::vector<ObjectPair>& pairs);
+
+	/**
+	 * @brief Finds pairs of triangle meshes and dynamic objects whose AABBs overlap
+	 * @param dynamicObjects Dynamic objects of the scene
+	 * @param[out] pairs Found pairs are appended to this vector
+	 */
+	void findMeshPairs(const std::vector<Object*>& dynamicObjects, std::vector<ObjectPair>& pairs);
+
+	/**
+	 * @brief Colours contact graph greedily in order of collisions, contact gets the first colour not used
+	 *        by its dynamic objects; static objects don't take part, their state isn't changed by responses
+	 */
+	void colorContacts();
+
+	/**
+	 * @brief Resolves found collisions colour by colour, contacts of one colour are resolved in parallel;
+	 *        order of responses of every object depends only on the colouring, not on number of threads
+	 */
+	void solveContacts();
+
+	/**
+	 * @brief Resolves contacts that share no dynamic object at once, contacts are gathered into arrays
+	 *        of solverBatchSize lanes, impulses are computed lane by lane and scattered back into objects;
+	 *        static object is represented by zero inverse mass, inertia and velocity
+	 * @param contacts Indices of collisions
+	 * @param count Number of contacts, at most solverBatchSize
+	 */
+	void solveContactBatch(const unsigned* contacts, unsigned count);
+
+	/**
+	 * @brief Removes penetration after velocities are solved, iterates over colours of contacts and
+	 *        accumulates linear displacements of objects, which only move them and are discarded afterwards
+	 */
+	void solvePositions();
+
+	/**
+	 * @brief Updates displacements of objects of one contact, so that their penetration is removed
+	 * @param index Index of the contact in collisions
+	 */
+	void solvePositionContact(unsigned index);
+
+	/**
+	 * @brief Applies impulses to all objects' linear and angular velocities accumulated throughout one update
+	 */
+	void applyImpulses();
+
+	/**
+	 * @brief Computes forces acting on all objects
+	 */
+	void computeForces();
+
+	/**
+	 * @brief Calculates impulses for collision response and stores them in objects' configuration
+	 * @param collision Collision data
+	 */
+	void collisionResponse(const CollisionData& collision);
+
+	/**
+	 * @brief Collision response for static and dynamic object
+	 * @param collision Collision data
+	 */
+	void collisionResponseStatic(const CollisionData& collision);
+
+	/**
+	 * @brief Collision response for dynamic objects
+	 * @param collision Collision data
+	 */
+	void collisionResponseDynamic(const CollisionData& collision);
+
+	/**
+	 * @brief Applies damping to linear and angular velocity if object's velocities are low
+	 * @param configuration Configuration of an object to which to apply damping
+	 */
+	void applyDamping(Object::Configuration& configuration);
+
+	/**
+	 * @brief Constructs skew-symmetric matrix for given vector
+	 * @param vector Vector for which to construct skew-symmetric matrix
+	 * @return Constructed skew-symmetric matrix
+	 */
+	glm::mat3 createSkewSymmetric(const glm::vec3& vector);
+};
+
+/**
+ * @brief Processes user input from keyboard
+ * @param window	Window whose input to process
+ */
+void processInput(GLFWwindow* window, float deltaTime);
+
+/**
+ * @brief Callback function, called when mouse is moved
+ * @param window	Window whose mouse input to be captured
+ * @param xpos		Actual position of mouse on x - axis
+ * @param ypos		Actual position of mouse on y - axis
+ */
+void mouseCallback(GLFWwindow* window, double xpos, double ypos);
+
+/**
+ * @brief Callback function for resizing viewport when window size is changed
+ * @param window	Window whose size to resize
+ * @param width		New width of viewport to be set
+ * @param height	New height of viewport to be set
+ */
+void framebufferSizeCallback(GLFWwindow* window, int width, int height);
+
 #endif
\ No newline at end of file
@@ -0,0 +1,111 @@
+/**
+ * Bakalarska praca - Simualace pevnych teles
+ * VUT FIT, 2018/2019
+ *
+ * Autor:	Denis Leitner, xleitn02
+ * Subor:	ThreadPool.cpp
+ *
+ */
+
+#include "ThreadPool.h"
+#include <algorithm>
+
+
+ThreadPool::ThreadPool(unsigned threadCount)
+{
+	task = NULL;
+	count = 0;
+	generation = 0;
+	pendingWorkers = 0;
+	stopping = false;
+
+	if (threadCount == 0)
+		threadCount = std::max(std::thread::hardware_concurrency(), 1u);
+
+	// calling thread is thread 0
+	for (unsigned i = 1; i < threadCount; i++)
+	{
+		workers.push_back(std::thread(&ThreadPool::workerLoop, this, i));
+	}
+}
+
+ThreadPool::~ThreadPool()
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		stopping = true;
+	}
+	startCondition.notify_all();
+
+	for (auto & worker : workers)
+	{
+		worker.join();
+	}
+}
+
+unsigned ThreadPool::getThreadCount()
+{
+	return workers.size() + 1;
+}
+
+void ThreadPool::parallelFor(unsigned count, const Task& task)
+{
+	if (workers.empty() || count < PARALLEL_MIN_ITEMS)
+	{
+		// not worth waking up workers, whole range is the part of thread 0
+		task(0, count, 0);
+		for (unsigned thread = 1; thread < getThreadCount(); thread++)
+			task(count, count, thread);
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		this->task = &task;
+		this->count = count;
+		pendingWorkers = workers.size();
+		generation++;
+	}
+	startCondition.notify_all();
+
+	runPart(0);
+
+	std::unique_lock<std::mutex> lock(mutex);
+	doneCondition.wait(lock, [this] { return pendingWorkers == 0; });
+	this->task = NULL;
+}
+
+void ThreadPool::workerLoop(unsigned thread)
+{
+	unsigned lastGeneration = 0;
+
+	while (true)
+	{
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			startCondition.wait(lock, [this, lastGeneration] { return stopping || generation != lastGeneration; });
+
+			if (stopping)
+				return;
+
+			lastGeneration = generation;
+		}
+
+		runPart(thread);
+
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			pendingWorkers--;
+		}
+		doneCondition.notify_one();
+	}
+}
+
+void ThreadPool::runPart(unsigned thread)
+{
+	unsigned threadCount = getThreadCount();
+	unsigned begin = (unsigned)((unsigned long long)count * thread / threadCount);
+	unsigned end = (unsigned)((unsigned long long)count * (thread + 1) / threadCount);
+
+	(*task)(begin, end, thread);
+}
@@ -0,0 +1,87 @@
+/**
+ * Bakalarska praca - Simualace pevnych teles
+ * VUT FIT, 2018/2019
+ *
+ * Autor:	Denis Leitner, xleitn02
+ * Subor:	ThreadPool.h
+ *
+ */
+
+#pragma once
+
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#define PARALLEL_MIN_ITEMS 256		// ranges with less items are processed by the calling thread only
+
+/**
+ * @brief Fixed set of worker threads that process parts of an index range, calling thread takes part in the work
+ */
+class ThreadPool
+{
+public:
+	/**
+	 * @brief Signature of a task, processes items [begin, end) of the range on thread with given index
+	 */
+	typedef std::function<void(unsigned begin, unsigned end, unsigned thread)> Task;
+
+	/**
+	 * @brief Creates worker threads
+	 * @param threadCount Number of threads including the calling one, 0 for number of hardware threads
+	 */
+	ThreadPool(unsigned threadCount = 0);
+
+	/**
+	 * @brief Stops and joins worker threads
+	 */
+	~ThreadPool();
+
+	/**
+	 * @brief Gets number of threads including the calling one
+	 */
+	unsigned getThreadCount();
+
+	/**
+	 * @brief Splits range [0, count) into contiguous parts, one per thread, and processes part i on thread i,
+	 *        returns when all parts are processed; the split depends only on count and number of threads,
+	 *        short ranges are processed whole by thread 0 and other threads get empty parts
+	 * @param count Number of items in the range
+	 * @param task Task processing one part of the range
+	 */
+	void parallelFor(unsigned count, const Task& task);
+
+private:
+	std::vector<std::thread> workers;
+	std::mutex mutex;
+	std::condition_variable startCondition;
+	std::condition_variable doneCondition;
+
+	// task being processed and number of its items
+	const Task* task;
+	unsigned count;
+	// incremented for every new task, workers wait for it to change
+	unsigned generation;
+	// number of workers that haven't finished current task
+	unsigned pendingWorkers;
+	bool stopping;
+
+	/**
+	 * @brief Main loop of worker thread
+	 * @param thread Index of the thread, calling thread has index 0
+	 */
+	void workerLoop(unsigned thread);
+
+	/**
+	 * @brief Processes part of current task belonging to given thread
+	 * @param thread Index of the thread
+	 */
+	void runPart(unsigned thread);
+};
+
+#endif
@@ -0,0 +1,204 @@
+/**
+ * Bakalarska praca - Simualace pevnych teles
+ * VUT FIT, 2018/2019
+ *
+ * Autor:	Denis Leitner, xleitn02
+ * Subor:	TriangleMesh.cpp
+ *
+ */
+
+#include "TriangleMesh.h"
+#include "Object.h"
+#include <algorithm>
+
+
+TriangleMesh::TriangleMesh()
+{
+	type = mesh;
+	boundsMin = glm::vec3(0.0f);
+	boundsMax = glm::vec3(0.0f);
+}
+
+void TriangleMesh::addTriangle(const glm::vec3& a, const glm::vec3& b, const glm::vec3& c, const glm::vec3& normal)
+{
+	glm::vec3 cross = glm::cross(b - a, c - a);
+	float length = glm::length(cross);
+
+	if (length < EPSILON)
+		return;
+
+	MeshTriangle triangle = { { a, b, c }, cross / length };
+
+	// winding of the file may be opposite to its normals
+	if (glm::dot(triangle.normal, normal) < 0.0f)
+	{
+		std::swap(triangle.vertices[1], triangle.vertices[2]);
+		triangle.normal = -triangle.normal;
+	}
+
+	triangles.push_back(triangle);
+}
+
+bool TriangleMesh::build()
+{
+	nodes.clear();
+
+	if (triangles.empty())
+		return false;
+
+	buildNode(0, triangles.size(), 0);
+
+	boundsMin = nodes[0].min;
+	boundsMax = nodes[0].max;
+	return true;
+}
+
+void TriangleMesh::buildNode(unsigned first, unsigned count, unsigned depth)
+{
+	unsigned nodeIndex = nodes.size();
+	nodes.push_back(MeshNode());
+
+	glm::vec3 min = triangles[first].vertices[0];
+	glm::vec3 max = triangles[first].vertices[0];
+
+	for (unsigned i = first; i < first + count; i++)
+	{
+		for (auto & vertex : triangles[i].vertices)
+		{
+			min = glm::min(min, vertex);
+			max = glm::max(max, vertex);
+		}
+	}
+
+	nodes[nodeIndex].min = min;
+	nodes[nodeIndex].max = max;
+
+	if (count <= MESH_LEAF_TRIANGLES || depth + 1 >= MESH_MAX_DEPTH)
+	{
+		nodes[nodeIndex].first = first;
+		nodes[nodeIndex].count = count;
+		return;
+	}
+
+	glm::vec3 extents = max - min;
+	int axis = 0;
+	if (extents.y > extents[axis])
+		axis = 1;
+	if (extents.z > extents[axis])
+		axis = 2;
+
+	// half of triangles with lower centroids go to the left subtree
+	unsigned half = count / 2;
+	std::nth_element(triangles.begin() + first, triangles.begin() + first + half, triangles.begin() + first + count,
+		[axis](const MeshTriangle& a, const MeshTriangle& b)
+	{
+		return a.vertices[0][axis] + a.vertices[1][axis] + a.vertices[2][axis] < b.vertices[0][axis] + b.vertices[1][axis] + b.vertices[2][axis];
+	});
+
+	nodes[nodeIndex].count = 0;
+	buildNode(first, half, depth + 1);
+	nodes[nodeIndex].right = nodes.size();
+	buildNode(first + half, count - half, depth + 1);
+}
+
+void TriangleMesh::findTriangles(const glm::vec3& min, const glm::vec3& max, std::vector<unsigned>& found) const
+{
+	found.clear();
+
+	if (nodes.empty())
+		return;
+
+	// every inner node on the path leaves at most its right child on the stack
+	unsigned stack[MESH_MAX_DEPTH + 1];
+	unsigned stackSize = 0;
+	stack[stackSize++] = 0;
+
+	while (stackSize > 0)
+	{
+		unsigned index = stack[--stackSize];
+		const MeshNode& node = nodes[index];
+
+		if (node.min.x > max.x || node.max.x < min.x
+			|| node.min.y > max.y || node.max.y < min.y
+			|| node.min.z > max.z || node.max.z < min.z)
+			continue;
+
+		if (node.count > 0)
+		{
+			for (unsigned i = node.first; i < node.first + node.count; i++)
+				found.push_back(i);
+			continue;
+		}
+
+		stack[stackSize++] = node.right;
+		stack[stackSize++] = index + 1;
+	}
+}
+
+glm::vec3 TriangleMesh::findClosestPoint(const glm::vec3* triangle, const glm::vec3& point)
+{
+	const glm::vec3& a = triangle[0];
+	const glm::vec3& b = triangle[1];
+	const glm::vec3& c = triangle[2];
+
+	// Voronoi regions of vertices, edges and face are tested one after another
+	glm::vec3 ab = b - a;
+	glm::vec3 ac = c - a;
+	glm::vec3 ap = point - a;
+
+	float d1 = glm::dot(ab, ap);
+	float d2 = glm::dot(ac, ap);
+	if (d1 <= 0.0f && d2 <= 0.0f)
+		return a;
+
+	glm::vec3 bp = point - b;
+	float d3 = glm::dot(ab, bp);
+	float d4 = glm::dot(ac, bp);
+	if (d3 >= 0.0f && d4 <= d3)
+		return b;
+
+	float vc = d1 * d4 - d3 * d2;
+	if (vc <= 0.0f && d1 >= 0.0f && d3 <= 0.0f)
+		return a + ab * (d1 / (d1 - d3));
+
+	glm::vec3 cp = point - c;
+	float d5 = glm::dot(ab, cp);
+	float d6 = glm::dot(ac, cp);
+	if (d6 >= 0.0f && d5 <= d6)
+		return c;
+
+	float vb = d5 * d2 - d1 * d6;
+	if (vb <= 0.0f && d2 >= 0.0f && d6 <= 0.0f)
+		return a + ac * (d2 / (d2 - d6));
+
+	float va = d3 * d6 - d5 * d4;
+	if (va <= 0.0f && d4 - d3 >= 0.0f && d5 - d6 >= 0.0f)
+		return b + (c - b) * ((d4 - d3) / ((d4 - d3) + (d5 - d6)));
+
+	float denominator = 1.0f / (va + vb + vc);
+	return a + ab * (vb * denominator) + ac * (vc * denominator);
+}
+
+bool TriangleMesh::isAboveTriangle(const glm::vec3* triangle, const glm::vec3& normal, const glm::vec3& point)
+{
+	// point must lie on the inner side of planes going through edges along normal
+	for (int i = 0; i < 3; i++)
+	{
+		const glm::vec3& tail = triangle[i];
+		const glm::vec3& head = triangle[(i + 1) % 3];
+
+		if (glm::dot(glm::cross(head - tail, point - tail), normal) < -EPSILON)
+			return false;
+	}
+
+	return true;
+}
+
+void TriangleMesh::calculateAttributes(Object* object)
+{
+	// mesh can't move, it behaves as an object with infinite density
+	object->centerOfMass = glm::vec3(0.0f);
+	object->mass = INFINITY;
+	object->inverseMass = 0.0f;
+	object->inverseBodyInertiaTensor = glm::mat3(0.0f);
+}
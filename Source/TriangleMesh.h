@@ -0,0 +1,113 @@
+/**
+ * Bakalarska praca - Simualace pevnych teles
+ * VUT FIT, 2018/2019
+ *
+ * Autor:	Denis Leitner, xleitn02
+ * Subor:	TriangleMesh.h
+ *
+ */
+
+#pragma once
+
+#ifndef TRIANGLE_MESH_H
+#define TRIANGLE_MESH_H
+
+#include <glm/glm.hpp>
+#include <vector>
+
+#include "Shape.h"
+
+// maximal number of triangles in leaf of triangle hierarchy
+constexpr unsigned MESH_LEAF_TRIANGLES = 4;
+// depth of triangle hierarchy is limited by stack of its queries, median split needs log2 of triangle count
+constexpr unsigned MESH_MAX_DEPTH = 64;
+
+/**
+ * @brief Triangle of static mesh in local space of the mesh
+ */
+struct MeshTriangle
+{
+	glm::vec3 vertices[3];	// vertices in counter-clockwise order seen from the front side
+	glm::vec3 normal;		// unit normal of the front side
+};
+
+/**
+ * @brief Node of bounding volume hierarchy of triangles, the left child of inner node follows it in array
+ */
+struct MeshNode
+{
+	glm::vec3 min;			// AABB of all triangles under the node
+	glm::vec3 max;
+	unsigned right;			// index of the right child node, valid only for inner nodes
+	unsigned first;			// index of the first triangle of leaf
+	unsigned count;			// number of triangles of leaf, 0 for inner nodes
+};
+
+/**
+ * @brief Static shape made of one-sided triangles, used for detailed scenery; objects are pushed out to the front side
+ */
+class TriangleMesh : public Shape
+{
+public:
+	// triangles reordered during build, so that every leaf covers continuous range of them
+	std::vector<MeshTriangle> triangles;
+	// bounds of all triangles in local space
+	glm::vec3 boundsMin;
+	glm::vec3 boundsMax;
+
+	TriangleMesh();
+
+	/**
+	 * @brief Adds triangle, degenerate triangles are skipped
+	 * @param a, b, c Vertices in local space
+	 * @param normal Normal of the face from model file, decides which side of the triangle is the front one
+	 */
+	void addTriangle(const glm::vec3& a, const glm::vec3& b, const glm::vec3& c, const glm::vec3& normal);
+
+	/**
+	 * @brief Builds hierarchy of added triangles
+	 * @return Whether hierarchy was built, false if mesh has no triangles
+	 */
+	bool build();
+
+	/**
+	 * @brief Finds triangles whose bounds overlap given box
+	 * @param min Minimal corner of the box in local space of the mesh
+	 * @param max Maximal corner of the box in local space of the mesh
+	 * @param[out] found Indices of found triangles, it is cleared first
+	 */
+	void findTriangles(const glm::vec3& min, const glm::vec3& max, std::vector<unsigned>& found) const;
+
+	/**
+	 * @brief Finds point of triangle closest to given point
+	 * @param triangle Triangle with vertices in the same space as the point
+	 * @param point Point for which to find closest point
+	 * @return Closest point of the triangle
+	 */
+	static glm::vec3 findClosestPoint(const glm::vec3* triangle, const glm::vec3& point);
+
+	/**
+	 * @brief Checks whether projection of point onto plane of triangle lies inside the triangle
+	 * @param triangle Triangle with vertices in the same space as the point
+	 * @param normal Normal of the triangle
+	 * @param point Point to be checked
+	 * @return Whether point lies above or below the triangle
+	 */
+	static bool isAboveTriangle(const glm::vec3* triangle, const glm::vec3& normal, const glm::vec3& point);
+
+	void calculateAttributes(Object* object) override;
+
+private:
+	// hierarchy of triangles, root is the first node
+	std::vector<MeshNode> nodes;
+
+	/**
+	 * @brief Builds subtree over range of triangles by splitting it by centroids of triangles along the longest axis
+	 * @param first Index of the first triangle of the range
+	 * @param count Number of triangles of the range
+	 * @param depth Depth of the subtree root
+	 */
+	void buildNode(unsigned first, unsigned count, unsigned depth);
+};
+
+#endif
@@ -0,0 +1,63 @@
+/**
+ * Bakalarska praca - Simualace pevnych teles
+ * VUT FIT, 2018/2019
+ *
+ * Autor:	Denis Leitner, xleitn02
+ * Subor:	SceneConverter.cpp
+ *
+ */
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+#include "Scene.h"
+
+/**
+ * @brief Loads scene and measures how long it took
+ * @param scene Scene into which to load
+ * @param path Scene file
+ * @param[out] milliseconds Duration of loading
+ * @return Whether scene was loaded
+ */
+static bool measureLoad(Scene& scene, const fs::path& path, double& milliseconds)
+{
+	auto start = std::chrono::high_resolution_clock::now();
+	bool loaded = scene.loadScene(path);
+	auto end = std::chrono::high_resolution_clock::now();
+
+	milliseconds = std::chrono::duration<double, std::milli>(end - start).count();
+	return loaded;
+}
+
+int main(int argc, char** argv)
+{
+	// usage: SceneConverter [scene number], binary scene is written next to the text one with extension .bin
+	int sceneNumber = argc > 1 ? atoi(argv[1]) : 1000;
+
+	fs::path textPath = fs::u8path(ROOT_DIR);
+	textPath += fs::path("Scenes/scene_" + std::to_string(sceneNumber));
+	fs::path binaryPath = textPath;
+	binaryPath += ".bin";
+
+	double textTime, binaryTime;
+	Scene textScene;
+
+	if (!measureLoad(textScene, textPath, textTime) || !textScene.saveBinaryScene(binaryPath))
+		return 1;
+
+	// binary scene is loaded back, so that broken file is found right away
+	Scene binaryScene;
+
+	if (!measureLoad(binaryScene, binaryPath, binaryTime) || binaryScene.objects.size() != textScene.objects.size())
+	{
+		std::cout << "Converted scene " << binaryPath << " doesn't match " << textPath << std::endl;
+		return 1;
+	}
+
+	std::cout << "Scene " << sceneNumber << " with " << textScene.objects.size() << " objects converted to " << binaryPath << std::endl;
+	std::cout << "Loading of text scene: " << textTime << " ms, binary scene: " << binaryTime << " ms" << std::endl;
+
+	return 0;
+}